@@ -44,6 +44,7 @@
 #include <iomanip>
 #include <limits>
 #include <list>
+#include <numeric>
 #include <sstream>
 
 namespace amrex {
@@ -90,6 +91,18 @@ namespace
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
     VisMF::Header::Version checkpoint_headerversion(VisMF::Header::Version_v1);
+
+    // The costs of all the boxes, on every rank.
+    Vector<Real> gather_costs (const LayoutData<Real>& costs)
+    {
+        Vector<Real> r(costs.size(), 0.0_rt);
+        const auto& idx = costs.IndexArray();
+        for (int i = 0, N = costs.local_size(); i < N; ++i) {
+            r[idx[i]] = costs.data()[i];
+        }
+        ParallelDescriptor::ReduceRealSum(r.data(), static_cast<int>(r.size()));
+        return r;
+    }
 }
 
 
@@ -495,6 +508,22 @@ Amr::InitAmr ()
 
     loadbalance_max_fac = 1.5;
     pp.queryAdd("loadbalance_max_fac", loadbalance_max_fac);
+
+    loadbalance_with_costs = 0;
+    pp.queryAdd("loadbalance_with_costs", loadbalance_with_costs);
+
+    loadbalance_costs_smoothing = 0.5;
+    pp.queryAdd("loadbalance_costs_smoothing", loadbalance_costs_smoothing);
+    AMREX_ALWAYS_ASSERT(loadbalance_costs_smoothing > 0.0_rt && loadbalance_costs_smoothing <= 1.0_rt);
+
+    loadbalance_costs_threshold = 0.9;
+    pp.queryAdd("loadbalance_costs_threshold", loadbalance_costs_threshold);
+
+    loadbalance_incremental = 0;
+    pp.queryAdd("loadbalance_incremental", loadbalance_incremental);
+
+    loadbalance_incremental_target = 0.95;
+    pp.queryAdd("loadbalance_incremental_target", loadbalance_incremental_target);
 }
 
 int
@@ -1987,6 +2016,10 @@ Amr::timeStep (int  level,
     Real dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
     BL_PROFILE_REGION_STOP("amr_level.advance");
 
+    if (loadbalance_with_costs) {
+        amr_level[level]->smoothCosts(loadbalance_costs_smoothing);
+    }
+
     dt_min[level] = iteration == 1 ? dt_new : std::min(dt_min[level],dt_new);
 
     level_steps[level]++;
@@ -2098,6 +2131,10 @@ Amr::coarseTimeStep (Real stop_time)
 
     amr_level[0]->postCoarseTimeStep(cumtime);
 
+    if (loadbalance_with_costs) {
+        LoadBalanceWithCosts();
+    }
+
 
     if (verbose > 0)
     {
@@ -2585,7 +2622,8 @@ Amr::regrid (int  lbase,
         // Construct skeleton of new level.
         //
 
-        if (loadbalance_with_workestimates && !initial) {
+        if ((loadbalance_with_workestimates || (loadbalance_with_costs && new_dmap[lev].empty()))
+            && !initial) {
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
@@ -2700,7 +2738,45 @@ Amr::makeLoadBalanceDistributionMap (int lev, Real time, const BoxArray& ba) con
 
     const int work_est_type = amr_level[0]->WorkEstType();
 
-    if (work_est_type < 0) {
+    if (loadbalance_with_costs && amr_level[lev] && amr_level[lev]->numCostSteps() > 0)
+    {
+        const BoxArray& oldba = boxArray(lev);
+        Vector<Real> oldcost = gather_costs(amr_level[lev]->smoothedCosts());
+
+        Vector<Real> rcost;
+        if (ba == oldba) {
+            rcost = std::move(oldcost);
+        } else {
+            // The cost of an old box is spread evenly over its cells.  New
+            // cells cost the average of the level.
+            Real avg = std::accumulate(oldcost.begin(), oldcost.end(), 0.0_rt)
+                / static_cast<Real>(oldba.numPts());
+            rcost.resize(ba.size());
+            std::vector<std::pair<int,Box> > isects;
+            for (int i = 0, N = static_cast<int>(ba.size()); i < N; ++i)
+            {
+                const Box bx = ba[i];
+                oldba.intersections(bx, isects);
+                Real c = 0.0_rt;
+                Long covered = 0;
+                for (auto const& is : isects) {
+                    const Long npts = is.second.numPts();
+                    c += oldcost[is.first] * static_cast<Real>(npts)
+                        / static_cast<Real>(oldba[is.first].numPts());
+                    covered += npts;
+                }
+                rcost[i] = c + avg * static_cast<Real>(bx.numPts()-covered);
+            }
+        }
+
+        Real eff;
+        newdm = makeCostDistributionMap(ba, rcost, eff);
+        if (verbose) {
+            amrex::Print() << "Load balance with measured costs on level " << lev
+                           << ": efficiency " << eff << "\n";
+        }
+    }
+    else if (work_est_type < 0) {
         if (verbose) {
             amrex::Print() << "\nAMREX WARNING: work estimates type does not exist!\n\n";
         }
@@ -2731,6 +2807,79 @@ Amr::makeLoadBalanceDistributionMap (int lev, Real time, const BoxArray& ba) con
     return newdm;
 }
 
+DistributionMapping
+Amr::makeCostDistributionMap (const BoxArray& ba, const Vector<Real>& rcost, Real& eff) const
+{
+    const auto how = DistributionMapping::strategy();
+    if (how == DistributionMapping::SFC || how == DistributionMapping::HILBERT) {
+        return DistributionMapping::makeSFC(rcost, ba, eff);
+    } else if (how == DistributionMapping::GRAPH) {
+        return DistributionMapping::makeGraph(rcost, ba, eff);
+    } else {
+        Real navg = static_cast<Real>(ba.size()) / static_cast<Real>(ParallelDescriptor::NProcs());
+        int nmax = static_cast<int>(std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg)));
+        return DistributionMapping::makeKnapSack(rcost, eff, nmax);
+    }
+}
+
+void
+Amr::LoadBalanceWithCosts ()
+{
+    BL_PROFILE("Amr::LoadBalanceWithCosts()");
+
+    // Wait until the smoothed costs have mostly forgotten the old mapping.
+    const int min_steps = static_cast<int>(std::ceil(1.0_rt/loadbalance_costs_smoothing));
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (amr_level[lev]->numCostSteps() < min_steps) { continue; }
+
+        // The measured efficiency needs only the sum of each rank.
+        auto const& costs = amr_level[lev]->smoothedCosts();
+        Real local = 0.0_rt;
+        for (int i = 0, N = costs.local_size(); i < N; ++i) {
+            local += costs.data()[i];
+        }
+        Real sum = local, max = local;
+        ParallelDescriptor::ReduceRealSum(sum);
+        ParallelDescriptor::ReduceRealMax(max);
+        const Real eff = (max > 0.0_rt)
+            ? sum / (static_cast<Real>(ParallelDescriptor::NProcs()) * max) : 1.0_rt;
+        if (eff >= loadbalance_costs_threshold) { continue; }
+
+        Vector<Real> rcost = gather_costs(costs);
+        Real new_eff;
+        DistributionMapping newdm;
+        if (loadbalance_incremental) {
+            // Move few boxes, rather than remapping them all.
+            Real old_eff;
+            Long moved_bytes;
+            newdm = DistributionMapping::makeIncremental(DistributionMap(lev), rcost, stateBytes(lev),
+                                                         loadbalance_incremental_target,
+                                                         old_eff, new_eff, moved_bytes);
+        } else {
+            newdm = makeCostDistributionMap(boxArray(lev), rcost, new_eff);
+        }
+
+        if (verbose) {
+            amrex::Print() << "Load balance with measured costs on level " << lev
+                           << ": efficiency " << eff << " -> " << new_eff
+                           << (new_eff > eff ? "\n" : ", keeping the old mapping\n");
+        }
+
+        if (new_eff > eff) {
+            // As after a regrid, post_regrid lets every level rebuild what
+            // depends on this level's DistributionMapping, such as flux
+            // registers.
+            InstallNewDistributionMap(lev, newdm);
+            for (int k = 0; k <= finest_level; ++k) {
+                amr_level[k]->post_regrid(lev, finest_level);
+            }
+            break;
+        }
+    }
+}
+
 void
 Amr::LoadBalanceLevel0 (Real time)
 {
@@ -2740,11 +2889,46 @@ Amr::LoadBalanceLevel0 (Real time)
     amr_level[0]->post_regrid(0,0);
 }
 
+Vector<Long>
+Amr::stateBytes (int lev) const
+{
+    const BoxArray& ba = boxArray(lev);
+    Vector<Long> bytes(ba.size(), 0);
+    for (int i = 0, N = AmrLevel::get_desc_lst().size(); i < N; ++i)
+    {
+        const StateData& sd = amr_level[lev]->get_state_data(i);
+        const MultiFab& mf = sd.newData();
+        const Long ntimes = sd.hasOldData() ? 2 : 1;
+        const Long bytes_per_cell = ntimes * mf.nComp() * static_cast<Long>(sizeof(Real));
+        for (int ib = 0, nb = static_cast<int>(ba.size()); ib < nb; ++ib) {
+            bytes[ib] += bytes_per_cell * mf.fabbox(ib).numPts();
+        }
+    }
+    return bytes;
+}
+
+Long
+Amr::movedBytes (int lev, const DistributionMapping& newdm) const
+{
+    const DistributionMapping& olddm = DistributionMap(lev);
+    Vector<Long> bytes = stateBytes(lev);
+    Long moved = 0;
+    for (int i = 0, N = static_cast<int>(bytes.size()); i < N; ++i) {
+        if (olddm[i] != newdm[i]) { moved += bytes[i]; }
+    }
+    return moved;
+}
+
 void
 Amr::InstallNewDistributionMap (int lev, const DistributionMapping& newdm)
 {
     BL_PROFILE("InstallNewDistributionMap()");
 
+    if (verbose > 0) {
+        amrex::Print() << "InstallNewDistributionMap on level " << lev << ": moving "
+                       << movedBytes(lev, newdm) << " bytes of state data\n";
+    }
+
     AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),boxArray(lev),newdm,cumtime);
     a->init(*amr_level[lev]);
     amr_level[lev].reset(a);
@@ -2068,6 +2068,38 @@ AmrLevel::estimateWork ()
     return static_cast<Real>(countCells());
 }
 
+LayoutData<Real>&
+AmrLevel::getCosts ()
+{
+    if (m_costs.boxArray() != grids || m_costs.DistributionMap() != dmap) {
+        m_costs.define(grids, dmap);
+        for (int i = 0, N = m_costs.local_size(); i < N; ++i) {
+            m_costs.data()[i] = 0.0_rt;
+        }
+    }
+    return m_costs;
+}
+
+void
+AmrLevel::smoothCosts (Real w)
+{
+    // Nothing was measured on this level.
+    if (m_costs.boxArray() != grids || m_costs.DistributionMap() != dmap) { return; }
+
+    if (m_num_cost_steps == 0 || m_smoothed_costs.DistributionMap() != dmap) {
+        m_smoothed_costs.define(grids, dmap);
+        m_num_cost_steps = 0;
+    }
+
+    Real* s = m_smoothed_costs.data();
+    Real* c = m_costs.data();
+    for (int i = 0, N = m_costs.local_size(); i < N; ++i) {
+        s[i] = (m_num_cost_steps == 0) ? c[i] : w*c[i] + (1.0_rt-w)*s[i];
+        c[i] = 0.0_rt;
+    }
+    ++m_num_cost_steps;
+}
+
 bool
 AmrLevel::writePlotNow ()
 {
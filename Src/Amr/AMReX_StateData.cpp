@@ -24,6 +24,16 @@ static constexpr Real INVALID_TIME = -1.0e200_rt;
 static constexpr int MFNEWDATA = 0;
 static constexpr int MFOLDDATA = 1;
 
+// Memory usage tag of the data of a state, after the name of its first component.
+static std::string mem_tag (const StateDescriptor& d)
+{
+    if (d.nComp() > 0 && !d.name(0).empty()) {
+        return "StateData " + d.name(0);
+    } else {
+        return "StateData unnamed";
+    }
+}
+
 Vector<std::string> StateData::fabArrayHeaderNames;
 std::map<std::string, Vector<char> > *StateData::faHeaderMap;
 
@@ -74,12 +84,12 @@ StateData::operator= (StateData const& rhs)
     new_time = rhs.new_time;
     old_time = rhs.old_time;
     new_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                          MFInfo().SetTag("StateData").SetArena(arena),
+                                          MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                           *m_factory);
     MultiFab::Copy(*new_data, *rhs.new_data, 0, 0, desc->nComp(),desc->nExtra());
     if (rhs.old_data) {
         old_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                              MFInfo().SetTag("StateData").SetArena(arena),
+                                              MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                               *m_factory);
         MultiFab::Copy(*old_data, *rhs.old_data, 0, 0, desc->nComp(),desc->nExtra());
     } else {
@@ -129,7 +139,7 @@ StateData::define (const Box&             p_domain,
     int ncomp = desc->nComp();
 
     new_data = std::make_unique<MultiFab>(grids,dmap,ncomp,desc->nExtra(),
-                                          MFInfo().SetTag("StateData").SetArena(arena),
+                                          MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                           *m_factory);
     old_data.reset();
 }
@@ -223,12 +233,12 @@ StateData::restartDoit (std::istream& is, const std::string& chkfile)
     is >> nsets;
 
     new_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                          MFInfo().SetTag("StateData").SetArena(arena),
+                                          MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                           *m_factory);
     old_data.reset();
     if (nsets == 2) {
         old_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                              MFInfo().SetTag("StateData").SetArena(arena),
+                                              MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                               *m_factory);
     }
     //
@@ -293,7 +303,7 @@ StateData::restart (const StateDescriptor& d,
     new_time.stop  = rhs.new_time.stop;
     old_data.reset();
     new_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                          MFInfo().SetTag("StateData").SetArena(arena),
+                                          MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                           *m_factory);
     new_data->setVal(0._rt);
 }
@@ -309,7 +319,7 @@ StateData::allocOldData ()
     if (old_data == nullptr)
     {
         old_data = std::make_unique<MultiFab>(grids,dmap,desc->nComp(),desc->nExtra(),
-                                              MFInfo().SetTag("StateData").SetArena(arena),
+                                              MFInfo().SetTag("StateData", mem_tag(*desc)).SetArena(arena),
                                               *m_factory);
     }
 }
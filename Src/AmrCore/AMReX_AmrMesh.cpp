@@ -4,6 +4,7 @@
 #include <AMReX_Cluster.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_PhaseArena.H>
 #include <AMReX_Print.H>
 
 namespace amrex {
@@ -105,6 +106,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.queryAdd("n_proper",n_proper);
     pp.queryAdd("grid_eff",grid_eff);
+    pp.queryAdd("distributed_cluster",distributed_cluster);
     int cnt = pp.countval("n_error_buf");
     if (cnt > 0) {
         Vector<int> neb;
@@ -502,6 +504,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 {
     BL_PROFILE("AmrMesh::MakeNewGrids()");
 
+    // The tags and their coarsened copies live only as long as the regrid.
+    PhaseArena phase_arena("AmrMesh::MakeNewGrids");
+
     BL_ASSERT(lbase < max_level);
 
     // Add at most one new level
@@ -682,10 +687,19 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         // Create initial cluster containing all tagged points.
         //
         Gpu::PinnedVector<IntVect> tagvec;
-        tags.collate(tagvec);
+        bool has_tags;
+        if (distributed_cluster) {
+            tags.local_collate(tagvec);
+            Long ntags = static_cast<Long>(tagvec.size());
+            ParallelDescriptor::ReduceLongSum(ntags);
+            has_tags = (ntags > 0);
+        } else {
+            tags.collate(tagvec);
+            has_tags = !tagvec.empty();
+        }
         tags.clear();
 
-        if (!tagvec.empty())
+        if (has_tags)
         {
             //
             // Created new level, now generate efficient grids.
@@ -696,23 +710,15 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 
             if (levf > useFixedUpToLevel()) {
                 BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
+                if (distributed_cluster) {
                     BL_PROFILE("AmrMesh-cluster");
                     //
-                    // Construct initial cluster.
-                    //
-                    ClusterList clist(&tagvec[0], static_cast<Long>(tagvec.size()));
-                    if (use_new_chop) {
-                        clist.new_chop(grid_eff);
-                    } else {
-                        clist.chop(grid_eff);
-                    }
-                    clist.intersect(p_n_ba[levc]);
+                    // Every process clusters its own tags, with the
+                    // signatures reduced across processes.
                     //
-                    // Efficient properly nested Clusters have been constructed
-                    // now generate list of grids at level levf.
-                    //
-                    clist.boxList(new_bx);
+                    new_bx = ClusterList::distributedChop(tagvec.data(),
+                                                          static_cast<Long>(tagvec.size()),
+                                                          grid_eff, p_n_ba[levc], use_new_chop);
                     new_bx.refine(bf_lev[levc]);
                     new_bx.simplify();
 
@@ -720,8 +726,34 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                         // Chop new grids outside domain
                         new_bx.intersect(Geom(levc).Domain());
                     }
+                } else {
+                    if (ParallelDescriptor::IOProcessor()) {
+                        BL_PROFILE("AmrMesh-cluster");
+                        //
+                        // Construct initial cluster.
+                        //
+                        ClusterList clist(&tagvec[0], static_cast<Long>(tagvec.size()));
+                        if (use_new_chop) {
+                            clist.new_chop(grid_eff);
+                        } else {
+                            clist.chop(grid_eff);
+                        }
+                        clist.intersect(p_n_ba[levc]);
+                        //
+                        // Efficient properly nested Clusters have been constructed
+                        // now generate list of grids at level levf.
+                        //
+                        clist.boxList(new_bx);
+                        new_bx.refine(bf_lev[levc]);
+                        new_bx.simplify();
+
+                        if (new_bx.size()>0) {
+                            // Chop new grids outside domain
+                            new_bx.intersect(Geom(levc).Domain());
+                        }
+                    }
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
 
                 //
                 // Refine up to levf.
@@ -1054,6 +1086,7 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  refine_grid_layout_dims = " << amr_mesh.refine_grid_layout_dims << "\n";
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
+    os << "  distributed_cluster = " << amr_mesh.distributed_cluster << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
     return os;
 }
@@ -5,9 +5,11 @@
 #include <AMReX_Vector.H>
 #include <AMReX_Array.H>
 #include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace amrex {
 
@@ -231,6 +233,55 @@ FindCut (const int* hist,
     return lo + cutpoint;
 }
 
+//
+// Finds cutpoint and cutstatus in each index direction but invalid_dir
+// (if any) and selects the best cutpoint and direction.
+//
+
+static
+int
+ChooseCut (Array<const int*,AMREX_SPACEDIM> const& hist,
+           const Box&                              bx,
+           int                                     invalid_dir,
+           IntVect&                                cut)
+{
+    const int* lo = bx.loVect();
+    const int* hi = bx.hiVect();
+
+    CutStatus mincut = InvalidCut;
+    CutStatus status[AMREX_SPACEDIM];
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        status[n] = InvalidCut;
+        if (n != invalid_dir)
+        {
+            cut[n] = FindCut(hist[n], lo[n], hi[n], status[n]);
+            if (status[n] < mincut)
+            {
+                mincut = status[n];
+            }
+        }
+    }
+    BL_ASSERT(mincut != InvalidCut);
+
+    int dir = -1;
+    for (int n = 0, minlen = -1; n < AMREX_SPACEDIM; n++)
+    {
+        if (status[n] == mincut)
+        {
+            int mincutlen = std::min(cut[n]-lo[n],hi[n]-cut[n]);
+            if (mincutlen >= minlen)
+            {
+                dir = n;
+                minlen = mincutlen;
+            }
+        }
+    }
+    BL_ASSERT(dir >= 0 && dir < AMREX_SPACEDIM);
+
+    return dir;
+}
+
 namespace {
 //
 // Predicate in call to std::partition() in Cluster::chop().
@@ -259,7 +310,6 @@ Cluster::chop ()
     BL_ASSERT(m_ar != nullptr);
 
     const int*    lo  = m_bx.loVect();
-    const int*    hi  = m_bx.hiVect();
     const IntVect len = m_bx.size();
     //
     // Compute histogram.
@@ -276,37 +326,11 @@ Cluster::chop ()
                 hist[2][p[2]-lo[2]]++; )
      }
     //
-    // Find cutpoint and cutstatus in each index direction.
-    //
-    CutStatus mincut = InvalidCut;
-    CutStatus status[AMREX_SPACEDIM];
-    IntVect cut;
-    for (int n = 0; n < AMREX_SPACEDIM; n++)
-    {
-        cut[n] = FindCut(hist[n].data(), lo[n], hi[n], status[n]);
-        if (status[n] < mincut)
-        {
-            mincut = status[n];
-        }
-    }
-    BL_ASSERT(mincut != InvalidCut);
-    //
     // Select best cutpoint and direction.
     //
-    int dir = -1;
-    for (int n = 0, minlen = -1; n < AMREX_SPACEDIM; n++)
-    {
-        if (status[n] == mincut)
-        {
-            int mincutlen = std::min(cut[n]-lo[n],hi[n]-cut[n]);
-            if (mincutlen >= minlen)
-            {
-                dir = n;
-                minlen = mincutlen;
-            }
-        }
-    }
-    BL_ASSERT(dir >= 0 && dir < AMREX_SPACEDIM);
+    IntVect cut;
+    const int dir = ChooseCut({AMREX_D_DECL(hist[0].data(),hist[1].data(),hist[2].data())},
+                              m_bx, -1, cut);
 
     Long nlo = 0;
     for (int i = lo[dir]; i < cut[dir]; i++) {
@@ -335,7 +359,6 @@ Cluster::new_chop ()
     BL_ASSERT(m_ar != nullptr);
 
     const int*    lo  = m_bx.loVect();
-    const int*    hi  = m_bx.hiVect();
     const IntVect len = m_bx.size();
     //
     // Compute histogram.
@@ -355,41 +378,12 @@ Cluster::new_chop ()
     int invalid_dir = -1;
     for (int n_try = 0; n_try < 2; n_try++)
     {
-       //
-       // Find cutpoint and cutstatus in each index direction.
-       //
-       CutStatus mincut = InvalidCut;
-       CutStatus status[AMREX_SPACEDIM];
-       IntVect cut;
-       for (int n = 0; n < AMREX_SPACEDIM; n++)
-       {
-           if (n != invalid_dir)
-           {
-              cut[n] = FindCut(hist[n].data(), lo[n], hi[n], status[n]);
-              if (status[n] < mincut)
-              {
-                  mincut = status[n];
-              }
-           }
-       }
-       BL_ASSERT(mincut != InvalidCut);
        //
        // Select best cutpoint and direction.
        //
-       int dir = -1;
-       for (int n = 0, minlen = -1; n < AMREX_SPACEDIM; n++)
-       {
-           if (status[n] == mincut) // NOLINT(clang-analyzer-core.UndefinedBinaryOperatorResult)
-           {
-               int mincutlen = std::min(cut[n]-lo[n],hi[n]-cut[n]);
-               if (mincutlen >= minlen)
-               {
-                   dir = n;
-                   minlen = mincutlen;
-               }
-           }
-       }
-       BL_ASSERT(dir >= 0 && dir < AMREX_SPACEDIM);
+       IntVect cut;
+       const int dir = ChooseCut({AMREX_D_DECL(hist[0].data(),hist[1].data(),hist[2].data())},
+                                 m_bx, invalid_dir, cut);
 
        Long nlo = 0;
        for (int i = lo[dir]; i < cut[dir]; i++) {
@@ -571,4 +565,294 @@ ClusterList::intersect (BoxArray& domba)
     domba.clear();
 }
 
+BoxList
+ClusterList::distributedChop (const IntVect*  pts,
+                              Long            len,
+                              Real            eff,
+                              const BoxArray& domba,
+                              bool            use_new_chop)
+{
+    BL_PROFILE("ClusterList::distributedChop()");
+
+    struct Node
+    {
+        Box  bx;
+        Long ntag = 0;
+        int  lo = -1;           // Clusters below and above the cut, if chopped.
+        int  hi = -1;
+        int  invalid_dir = -1;  // Direction of a cut rejected by new_chop.
+    };
+
+    auto node_eff = [] (const Node& nd) {
+        return static_cast<Real>(double(nd.ntag) / nd.bx.d_numPts());
+    };
+
+    Vector<Node> node(1);
+    //
+    // Cluster of each local point, -1 once it has been dropped.
+    //
+    Vector<int> owner(len, 0);
+    //
+    // Minimal boxes of clusters [first,last) from their distributed points.
+    //
+    auto min_boxes = [&] (int first, int last)
+    {
+        const int nb = 2*AMREX_SPACEDIM;
+        Vector<int> b(std::size_t(nb)*(last-first), std::numeric_limits<int>::max());
+        for (Long i = 0; i < len; i++)
+        {
+            const int o = owner[i];
+            if (o >= first && o < last)
+            {
+                int* q = b.data() + std::size_t(nb)*(o-first);
+                for (int d = 0; d < AMREX_SPACEDIM; d++)
+                {
+                    q[d]                = std::min(q[d],                 pts[i][d]);
+                    q[d+AMREX_SPACEDIM] = std::min(q[d+AMREX_SPACEDIM], -pts[i][d]);
+                }
+            }
+        }
+        ParallelDescriptor::ReduceIntMin(b.data(), static_cast<int>(b.size()));
+        for (int o = first; o < last; o++)
+        {
+            if (node[o].ntag > 0)
+            {
+                const int* q = b.data() + std::size_t(nb)*(o-first);
+                IntVect lo, hi;
+                for (int d = 0; d < AMREX_SPACEDIM; d++)
+                {
+                    lo[d] =  q[d];
+                    hi[d] = -q[d+AMREX_SPACEDIM];
+                }
+                node[o].bx = Box(lo,hi);
+            }
+        }
+    };
+
+    node[0].ntag = len;
+    ParallelDescriptor::ReduceLongSum(node[0].ntag);
+    if (node[0].ntag == 0) {
+        return BoxList();
+    }
+    min_boxes(0,1);
+    //
+    // Chop all clusters of poor efficiency at once in each pass.  The
+    // signatures are summed over all processes so that every process
+    // picks the same cuts as Cluster::chop() or Cluster::new_chop().
+    //
+    Vector<int> open(1, 0);
+    while (true)
+    {
+        Vector<int> act;
+        for (int o : open) {
+            if (node_eff(node[o]) < eff) {
+                act.push_back(o);
+            }
+        }
+        if (act.empty()) {
+            break;
+        }
+
+        const int nact = static_cast<int>(act.size());
+        Vector<int> slot(node.size(), -1);
+        Vector<int> off(std::size_t(nact)*AMREX_SPACEDIM+1, 0);
+        for (int a = 0; a < nact; a++)
+        {
+            slot[act[a]] = a;
+            for (int d = 0; d < AMREX_SPACEDIM; d++) {
+                off[a*AMREX_SPACEDIM+d+1] = off[a*AMREX_SPACEDIM+d] + node[act[a]].bx.length(d);
+            }
+        }
+
+        Vector<int> hist(off.back(), 0);
+        for (Long i = 0; i < len; i++)
+        {
+            const int a = (owner[i] >= 0) ? slot[owner[i]] : -1;
+            if (a >= 0)
+            {
+                const IntVect& lo = node[act[a]].bx.smallEnd();
+                for (int d = 0; d < AMREX_SPACEDIM; d++) {
+                    hist[off[a*AMREX_SPACEDIM+d] + pts[i][d]-lo[d]]++;
+                }
+            }
+        }
+        ParallelDescriptor::ReduceIntSum(hist.data(), static_cast<int>(hist.size()));
+
+        const int first = static_cast<int>(node.size());
+        Vector<int>  cutdir(nact), cutloc(nact);
+        Vector<char> tentative(nact, 0);
+        for (int a = 0; a < nact; a++)
+        {
+            const Box  bx   = node[act[a]].bx;
+            const Long ntag = node[act[a]].ntag;
+
+            Array<const int*,AMREX_SPACEDIM> h;
+            for (int d = 0; d < AMREX_SPACEDIM; d++) {
+                h[d] = hist.data() + off[a*AMREX_SPACEDIM+d];
+            }
+            auto count_lo = [&] (int dir, const IntVect& cut) {
+                Long nlo = 0;
+                for (int i = bx.smallEnd(dir); i < cut[dir]; i++) {
+                    nlo += h[dir][i-bx.smallEnd(dir)];
+                }
+                return nlo;
+            };
+
+            IntVect cut;
+            int dir;
+            Long nlo;
+            if (use_new_chop)
+            {
+                dir = ChooseCut(h, bx, node[act[a]].invalid_dir, cut);
+                nlo = count_lo(dir, cut);
+                if (nlo <= 0 || nlo >= ntag)
+                {
+                    dir = ChooseCut(h, bx, -1, cut);
+                    nlo = count_lo(dir, cut);
+                }
+                else
+                {
+                    tentative[a] = (node[act[a]].invalid_dir < 0);
+                }
+            }
+            else
+            {
+                dir = ChooseCut(h, bx, -1, cut);
+                nlo = count_lo(dir, cut);
+            }
+            BL_ASSERT(nlo > 0 && nlo < ntag);
+
+            cutdir[a] = dir;
+            cutloc[a] = cut[dir];
+            node.push_back(Node());
+            node.back().ntag = nlo;
+            node.push_back(Node());
+            node.back().ntag = ntag - nlo;
+        }
+
+        for (Long i = 0; i < len; i++)
+        {
+            const int a = (owner[i] >= 0) ? slot[owner[i]] : -1;
+            if (a >= 0) {
+                owner[i] = first + 2*a + ((pts[i][cutdir[a]] < cutloc[a]) ? 0 : 1);
+            }
+        }
+        min_boxes(first, static_cast<int>(node.size()));
+
+        Vector<int> next;
+        Vector<int> reject(nact, -1);
+        for (int a = 0; a < nact; a++)
+        {
+            Node& nd = node[act[a]];
+            const int lo = first + 2*a;
+            const int hi = lo + 1;
+            if (tentative[a] && !(node_eff(node[lo]) > node_eff(nd) ||
+                                  node_eff(node[hi]) > node_eff(nd)))
+            {
+                //
+                // Neither half is more efficient; try another direction.
+                //
+                nd.invalid_dir = cutdir[a];
+                reject[a] = act[a];
+                next.push_back(act[a]);
+            }
+            else
+            {
+                nd.lo = lo;
+                nd.hi = hi;
+                next.push_back(lo);
+                next.push_back(hi);
+            }
+        }
+        for (Long i = 0; i < len; i++)
+        {
+            if (owner[i] >= first && reject[(owner[i]-first)/2] >= 0) {
+                owner[i] = reject[(owner[i]-first)/2];
+            }
+        }
+        open = std::move(next);
+    }
+    //
+    // Replay the splits in the order ClusterList::chop() visits them.
+    //
+    std::list<int> lst(1, 0);
+    for (auto cli = lst.begin(); cli != lst.end(); )
+    {
+        if (node[*cli].lo >= 0)
+        {
+            lst.push_back(node[*cli].hi);
+            *cli = node[*cli].lo;
+        }
+        else
+        {
+            ++cli;
+        }
+    }
+    //
+    // Intersect with domba as ClusterList::intersect() does.
+    //
+    BoxArray dba(domba);
+    dba.removeOverlap();
+    BoxDomain dom(dba.boxList());
+
+    BoxList blst;
+    const int first = static_cast<int>(node.size());
+    Vector<int> pbegin(first, -1), pend(first, -1);
+    for (int o : lst)
+    {
+        bool assume_disjoint_ba = true;
+        if (dba.contains(node[o].bx,assume_disjoint_ba))
+        {
+            blst.push_back(node[o].bx);
+        }
+        else
+        {
+            BoxDomain bxdom;
+            amrex::intersect(bxdom, dom, node[o].bx);
+            pbegin[o] = static_cast<int>(node.size());
+            for (const auto& b : bxdom)
+            {
+                node.push_back(Node());
+                node.back().bx = b;
+            }
+            pend[o] = static_cast<int>(node.size());
+        }
+    }
+
+    const int last = static_cast<int>(node.size());
+    if (last > first)
+    {
+        Vector<Long> cnt(last-first, 0);
+        for (Long i = 0; i < len; i++)
+        {
+            const int o = owner[i];
+            if (o >= 0 && pbegin[o] >= 0)
+            {
+                owner[i] = -1;
+                for (int p = pbegin[o]; p < pend[o]; p++)
+                {
+                    if (node[p].bx.contains(pts[i]))
+                    {
+                        owner[i] = p;
+                        ++cnt[p-first];
+                        break;
+                    }
+                }
+            }
+        }
+        ParallelDescriptor::ReduceLongSum(cnt.data(), last-first);
+        for (int p = first; p < last; p++) {
+            node[p].ntag = cnt[p-first];
+        }
+        min_boxes(first, last);
+        for (int p = first; p < last; p++) {
+            if (node[p].ntag > 0) {
+                blst.push_back(node[p].bx);
+            }
+        }
+    }
+
+    return blst;
+}
+
 }
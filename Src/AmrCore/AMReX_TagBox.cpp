@@ -5,6 +5,7 @@
 #include <AMReX_ccse-mpi.H>
 #include <AMReX_iMultiFab.H>
 #include <AMReX_MultiFabUtil.H>
+#include <AMReX_PhaseArena.H>
 
 #include <algorithm>
 #include <cstdlib>
@@ -35,7 +36,7 @@ TagBox::coarsen (const IntVect& ratio, const Box& cbox) noexcept
     BL_ASSERT(nComp() == 1);
     Array4<char const> const& farr = this->const_array();
 
-    TagBox cfab(cbox, 1, The_Arena());
+    TagBox cfab(cbox, 1, PhaseArena::Current(The_Arena()));
     Elixir eli = cfab.elixir();
     Array4<char> const& carr = cfab.array();
 
@@ -287,7 +288,8 @@ TagBoxArray::TagBoxArray (const BoxArray& ba,
                           const DistributionMapping& dm,
                           int             _ngrow)
     :
-    FabArray<TagBox>(ba,dm,1,_ngrow,MFInfo(),DefaultFabFactory<TagBox>())
+    FabArray<TagBox>(ba,dm,1,_ngrow,MFInfo().SetArena(PhaseArena::Current(The_Arena())),
+                     DefaultFabFactory<TagBox>())
 {
     setVal(TagBox::CLEAR);
 }
@@ -296,7 +298,8 @@ TagBoxArray::TagBoxArray (const BoxArray& ba,
                           const DistributionMapping& dm,
                           const IntVect&  _ngrow)
     :
-    FabArray<TagBox>(ba,dm,1,_ngrow,MFInfo(),DefaultFabFactory<TagBox>())
+    FabArray<TagBox>(ba,dm,1,_ngrow,MFInfo().SetArena(PhaseArena::Current(The_Arena())),
+                     DefaultFabFactory<TagBox>())
 {
     setVal(TagBox::CLEAR);
 }
@@ -589,19 +592,25 @@ TagBoxArray::local_collate_gpu (Gpu::PinnedVector<IntVect>& v) const
 #endif
 
 void
-TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Gpu::PinnedVector<IntVect>& v) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
-
-    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
-        local_collate_gpu(TheLocalCollateSpace);
+        local_collate_gpu(v);
     } else
 #endif
     {
-        local_collate_cpu(TheLocalCollateSpace);
+        local_collate_cpu(v);
     }
+}
+
+void
+TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
 
     Long count = static_cast<Long>(TheLocalCollateSpace.size());
 
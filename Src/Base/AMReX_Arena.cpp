@@ -3,6 +3,7 @@
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
 #include <AMReX_PArena.H>
+#include <AMReX_PhaseArena.H>
 
 #include <AMReX.H>
 #include <AMReX_BLProfiler.H>
@@ -10,6 +11,20 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Gpu.H>
+#include <AMReX_OpenMP.H>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#endif
 
 #ifdef _WIN32
 ///#include <memoryapi.h>
@@ -44,12 +59,147 @@ namespace {
     Long the_managed_arena_release_threshold = std::numeric_limits<Long>::max();
     Long the_pinned_arena_release_threshold = std::numeric_limits<Long>::max();
     Long the_async_arena_release_threshold = std::numeric_limits<Long>::max();
+    Long the_arena_thread_cache = 0L;
 #ifdef AMREX_USE_HIP
     bool the_arena_is_managed = false; // xxxxx HIP FIX HERE
 #else
     bool the_arena_is_managed = true;
 #endif
     bool abort_on_out_of_gpu_memory = false;
+    bool the_cpu_arena_huge_pages = false;
+    Long the_cpu_arena_huge_page_size = 0L;
+    std::string the_cpu_arena_numa = "none";
+
+    NumaPolicy toNumaPolicy (std::string const& name)
+    {
+        if (name == "none") {
+            return NumaPolicy::none;
+        } else if (name == "interleave") {
+            return NumaPolicy::interleave;
+        } else if (name == "first_touch") {
+            return NumaPolicy::first_touch;
+        } else {
+            amrex::Abort("amrex.the_cpu_arena_numa: unknown policy " + name);
+            return NumaPolicy::none;
+        }
+    }
+
+#ifdef __linux__
+    // The pages are mapped in multiples of this.
+    std::size_t map_granularity (ArenaInfo const& info)
+    {
+        if (info.use_huge_pages) {
+            // Transparent huge pages are 2 MB on x86-64 and most aarch64 kernels.
+            return (info.huge_page_size > 0) ? std::size_t(info.huge_page_size) : std::size_t(2*1024*1024);
+        } else {
+            return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        }
+    }
+
+    constexpr int max_numa_nodes = 1024;
+    using NodeMask = std::array<unsigned long, max_numa_nodes/(8*sizeof(unsigned long))>;
+
+    // The NUMA nodes this process may allocate memory on.
+    NodeMask const& allowed_numa_nodes ()
+    {
+        static const NodeMask mask = [] ()
+        {
+            constexpr int bits = 8*sizeof(unsigned long);
+            constexpr unsigned long mpol_f_mems_allowed = 4;
+            NodeMask m{};
+            int mode = 0;
+            if (syscall(SYS_get_mempolicy, &mode, m.data(), max_numa_nodes, nullptr,
+                        mpol_f_mems_allowed) == 0) {
+                return m;
+            }
+            // Otherwise the online nodes, e.g., "0-3,6".
+            m.fill(0);
+            std::ifstream ifs("/sys/devices/system/node/online");
+            std::string range;
+            while (std::getline(ifs, range, ',')) {
+                int lo = 0, hi = 0;
+                const int nread = std::sscanf(range.c_str(), "%d-%d", &lo, &hi);
+                if (nread < 1) { continue; }
+                if (nread == 1) { hi = lo; }
+                for (int i = std::max(lo,0); i <= hi && i < max_numa_nodes; ++i) {
+                    m[i/bits] |= 1UL << (i%bits);
+                }
+            }
+            if (std::all_of(m.begin(), m.end(), [] (unsigned long x) { return x == 0; })) {
+                m[0] = 1UL;
+            }
+            return m;
+        }();
+        return mask;
+    }
+
+    void* map_pages (std::size_t nbytes, ArenaInfo const& info)
+    {
+        const std::size_t n = amrex::aligned_size(map_granularity(info), nbytes);
+        void* p = MAP_FAILED;
+
+        if (info.use_huge_pages && info.huge_page_size > 0) {
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+            int log2size = 0;
+            while ((Long(1) << log2size) < info.huge_page_size) { ++log2size; }
+            flags |= log2size << MAP_HUGE_SHIFT;
+#endif
+            p = mmap(nullptr, n, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (p == MAP_FAILED) {
+                static bool warned = false;
+                if (!warned) {
+                    warned = true;
+                    amrex::Warning("Arena: no huge pages of the requested size are available, "
+                                   "transparent huge pages are used instead");
+                }
+            }
+        }
+
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) { return nullptr; }
+            if (info.use_huge_pages) {
+                madvise(p, n, MADV_HUGEPAGE);
+            }
+        }
+
+        if (info.numa_policy == NumaPolicy::interleave) {
+            // MPOL_INTERLEAVE over the nodes we may use.  mbind rejects
+            // nodes outside of them.  The kernel ignores the last bit of
+            // maxnode.
+            constexpr int mpol_interleave = 3;
+            NodeMask const& nodes = allowed_numa_nodes();
+            if (syscall(SYS_mbind, p, n, mpol_interleave, nodes.data(), max_numa_nodes+1, 0) != 0) {
+                static bool warned = false;
+                if (!warned) {
+                    warned = true;
+                    amrex::Warning(std::string("Arena: mbind failed (") + std::strerror(errno)
+                                   + "), the pages are not interleaved over NUMA nodes");
+                }
+            }
+        } else if (info.numa_policy == NumaPolicy::first_touch) {
+            // Contiguous parts to the threads in order, like a statically
+            // scheduled MFIter loop over the tiles of a box.
+            const auto page = static_cast<Long>(map_granularity(info));
+            const auto npages = static_cast<Long>(n) / page;
+            auto* c = static_cast<char*>(p);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(static) if (!OpenMP::in_parallel())
+#endif
+            for (Long i = 0; i < npages; ++i) {
+                c[i*page] = 0;
+            }
+        }
+
+        return p;
+    }
+
+    void unmap_pages (void* p, std::size_t nbytes, ArenaInfo const& info)
+    {
+        munmap(p, amrex::aligned_size(map_granularity(info), nbytes));
+    }
+#endif
 }
 
 const std::size_t Arena::align_size;
@@ -136,7 +286,14 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
 #ifdef AMREX_USE_GPU
     if (arena_info.use_cpu_memory)
     {
-        p = std::malloc(nbytes);
+#ifdef __linux__
+        if (arena_info.mapsPages()) {
+            p = map_pages(nbytes, arena_info);
+        } else
+#endif
+        {
+            p = std::malloc(nbytes);
+        }
 #ifndef _WIN32
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -196,7 +353,14 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
         }
     }
 #else
-    p = std::malloc(nbytes);
+#ifdef __linux__
+    if (arena_info.mapsPages() && !arena_info.device_use_hostalloc) {
+        p = map_pages(nbytes, arena_info);
+    } else
+#endif
+    {
+        p = std::malloc(nbytes);
+    }
 #ifndef _WIN32
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -212,6 +376,21 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
     return p;
 }
 
+std::size_t
+Arena::system_alloc_size (std::size_t nbytes) const
+{
+#ifdef __linux__
+#ifdef AMREX_USE_GPU
+    if (arena_info.use_cpu_memory && arena_info.mapsPages()) {
+#else
+    if (arena_info.mapsPages() && !arena_info.device_use_hostalloc) {
+#endif
+        return amrex::aligned_size(map_granularity(arena_info), nbytes);
+    }
+#endif
+    return nbytes;
+}
+
 void
 Arena::deallocate_system (void* p, std::size_t nbytes) // NOLINT(readability-make-member-function-const)
 {
@@ -219,7 +398,14 @@ Arena::deallocate_system (void* p, std::size_t nbytes) // NOLINT(readability-mak
     if (arena_info.use_cpu_memory)
     {
         if (p && arena_info.device_use_hostalloc) AMREX_MUNLOCK(p, nbytes);
-        std::free(p);
+#ifdef __linux__
+        if (arena_info.mapsPages()) {
+            unmap_pages(p, nbytes, arena_info);
+        } else
+#endif
+        {
+            std::free(p);
+        }
     }
     else if (arena_info.device_use_hostalloc)
     {
@@ -237,7 +423,14 @@ Arena::deallocate_system (void* p, std::size_t nbytes) // NOLINT(readability-mak
     }
 #else
     if (p && arena_info.device_use_hostalloc) AMREX_MUNLOCK(p, nbytes);
-    std::free(p);
+#ifdef __linux__
+    if (arena_info.mapsPages() && !arena_info.device_use_hostalloc) {
+        unmap_pages(p, nbytes, arena_info);
+    } else
+#endif
+    {
+        std::free(p);
+    }
 #endif
 }
 
@@ -297,36 +490,55 @@ Arena::Initialize ()
     pp.queryAdd("the_managed_arena_release_threshold", the_managed_arena_release_threshold);
     pp.queryAdd( "the_pinned_arena_release_threshold",  the_pinned_arena_release_threshold);
     pp.queryAdd(  "the_async_arena_release_threshold",   the_async_arena_release_threshold);
+    pp.queryAdd("the_arena_thread_cache", the_arena_thread_cache);
+    pp.queryAdd("the_cpu_arena_huge_pages", the_cpu_arena_huge_pages);
+    pp.queryAdd("the_cpu_arena_huge_page_size", the_cpu_arena_huge_page_size);
+    pp.queryAdd("the_cpu_arena_numa", the_cpu_arena_numa);
+
+    auto cpu_ai = ArenaInfo{}.SetCpuMemory()
+        .SetHugePages(the_cpu_arena_huge_pages, the_cpu_arena_huge_page_size)
+        .SetNumaPolicy(toNumaPolicy(the_cpu_arena_numa));
     pp.queryAdd("the_arena_is_managed", the_arena_is_managed);
     pp.queryAdd("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
 
     {
 #if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
-        ArenaInfo ai{};
-        ai.SetReleaseThreshold(the_arena_release_threshold);
-        if (the_arena_is_managed) {
-            the_arena = new CArena(0, ai.SetPreferred());
-#ifdef AMREX_USE_GPU
-            the_arena->registerForProfiling("Managed Memory");
+        const bool use_carena = true;
 #else
-            the_arena->registerForProfiling("Cpu Memory");
+        // The thread caches and the page options of the CPU arena need a CArena.
+        const bool use_carena = the_arena_thread_cache > 0 || cpu_ai.mapsPages();
 #endif
-        } else {
-            the_arena = new CArena(0, ai.SetDeviceMemory());
+        if (use_carena) {
+            ArenaInfo ai{};
+            ai.SetReleaseThreshold(the_arena_release_threshold)
+              .SetThreadCache(the_arena_thread_cache);
+#ifndef AMREX_USE_GPU
+            ai.SetHugePages(cpu_ai.use_huge_pages, cpu_ai.huge_page_size)
+              .SetNumaPolicy(cpu_ai.numa_policy);
+#endif
+            if (the_arena_is_managed) {
+                the_arena = new CArena(0, ai.SetPreferred());
 #ifdef AMREX_USE_GPU
-            the_arena->registerForProfiling("Device Memory");
+                the_arena->registerForProfiling("Managed Memory");
 #else
-            the_arena->registerForProfiling("Cpu Memory");
+                the_arena->registerForProfiling("Cpu Memory");
 #endif
-        }
+            } else {
+                the_arena = new CArena(0, ai.SetDeviceMemory());
 #ifdef AMREX_USE_GPU
-        BL_PROFILE("The_Arena::Initialize()");
-        void *p = the_arena->alloc(static_cast<std::size_t>(the_arena_init_size));
-        the_arena->free(p);
-#endif
+                the_arena->registerForProfiling("Device Memory");
 #else
-        the_arena = The_BArena();
+                the_arena->registerForProfiling("Cpu Memory");
+#endif
+            }
+#ifdef AMREX_USE_GPU
+            BL_PROFILE("The_Arena::Initialize()");
+            void *p = the_arena->alloc(static_cast<std::size_t>(the_arena_init_size));
+            the_arena->free(p);
 #endif
+        } else {
+            the_arena = The_BArena();
+        }
     }
 
     the_async_arena = new PArena(the_async_arena_release_threshold);
@@ -379,7 +591,19 @@ Arena::Initialize ()
         the_pinned_arena->free(p);
     }
 
-    the_cpu_arena = The_BArena();
+    if (!cpu_ai.mapsPages()) {
+        the_cpu_arena = The_BArena();
+    } else {
+#ifdef AMREX_USE_GPU
+        the_cpu_arena = new CArena(0, cpu_ai);
+        the_cpu_arena->registerForProfiling("Cpu Memory");
+#else
+        // The_Arena is the CPU arena.
+        the_cpu_arena = the_arena;
+#endif
+    }
+
+    PhaseArena::Initialize();
 
     // Initialize the null arena
     auto* null_arena = The_Null_Arena();
@@ -523,6 +747,13 @@ Arena::Finalize ()
         the_managed_arena = nullptr;
     }
 
+    if (!dynamic_cast<BArena*>(the_cpu_arena)) {
+        if (the_cpu_arena != the_arena) {
+            delete the_cpu_arena;
+        }
+        the_cpu_arena = nullptr;
+    }
+
     if (!dynamic_cast<BArena*>(the_arena)) {
         delete the_arena;
         the_arena = nullptr;
@@ -533,11 +764,6 @@ Arena::Finalize ()
 
     delete the_pinned_arena;
     the_pinned_arena = nullptr;
-
-    if (!dynamic_cast<BArena*>(the_cpu_arena)) {
-        delete the_cpu_arena;
-        the_cpu_arena = nullptr;
-    }
 }
 
 Arena*
@@ -12,17 +12,49 @@ namespace amrex {
 }
 #endif
 
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
 #include <utility>
 #include <cstring>
 
 namespace amrex {
 
+namespace {
+    // Blocks obtained from the arena at once on a miss of a thread cache
+    constexpr std::size_t thread_cache_refill_bytes = 64*1024;
+    constexpr int thread_cache_max_refill = 16;
+
+    // The size class of nbytes, or -1 if it is too big for the thread caches.
+    int size_class (std::size_t nbytes) noexcept
+    {
+        int c = 0;
+        while ((std::size_t(1) << (c+CArena::MinSizeClassLog2)) < nbytes) {
+            if (++c == CArena::NumSizeClasses) { return -1; }
+        }
+        return c;
+    }
+
+    constexpr std::size_t class_bytes (int c) noexcept
+    {
+        return std::size_t(1) << (c+CArena::MinSizeClassLog2);
+    }
+}
+
 CArena::CArena (std::size_t hunk_size, ArenaInfo info)
     : m_hunk(align(hunk_size == 0 ? DefaultHunkSize : hunk_size))
 {
     arena_info = info;
     BL_ASSERT(m_hunk >= hunk_size);
     BL_ASSERT(m_hunk%Arena::align_size == 0);
+
+#ifdef AMREX_USE_OMP
+    if (arena_info.thread_cache_bytes > 0 && !isDevice()) {
+        m_thread_cache.resize(OpenMP::get_max_threads());
+        m_thread_cache_bytes = static_cast<std::size_t>(arena_info.thread_cache_bytes);
+        m_header = Arena::align_size;
+    }
+#endif
 }
 
 CArena::~CArena ()
@@ -41,14 +73,66 @@ CArena::~CArena ()
 void*
 CArena::alloc (std::size_t nbytes)
 {
-    std::lock_guard<std::mutex> lock(carena_mutex);
+    if (m_thread_cache.empty()) {
+        std::lock_guard<std::mutex> lock(carena_mutex);
+        return alloc_protected(nbytes);
+    }
 
+    const int c = size_class(nbytes);
+    ThreadCache* tc = (c >= 0) ? threadCache() : nullptr;
+    char* p = nullptr;
+    if (tc == nullptr) {
+        std::lock_guard<std::mutex> lock(carena_mutex);
+        p = static_cast<char*>(alloc_protected(nbytes+m_header));
+        const int nocache = -1;
+        std::memcpy(p, &nocache, sizeof(int));
+    } else {
+        auto& bin = tc->bins[c];
+        if (bin.empty()) {
+            ++tc->misses;
+            const std::size_t cb = class_bytes(c);
+            const auto room = (m_thread_cache_bytes > tc->bytes)
+                ? static_cast<int>((m_thread_cache_bytes - tc->bytes) / (cb+m_header)) : 0;
+            const int nextra = std::min({room,
+                                         static_cast<int>(thread_cache_refill_bytes/cb),
+                                         thread_cache_max_refill}) - 1;
+            std::lock_guard<std::mutex> lock(carena_mutex);
+            for (int i = 0; i < nextra; ++i) {
+                bin.push_back(alloc_protected(cb+m_header, true));
+                std::memcpy(bin.back(), &c, sizeof(int));
+            }
+            tc->bytes += std::max(nextra,0) * cb;
+            p = static_cast<char*>(alloc_protected(cb+m_header, true));
+            std::memcpy(p, &c, sizeof(int));
+        } else {
+            ++tc->hits;
+            p = static_cast<char*>(bin.back());
+            bin.pop_back();
+            tc->bytes -= class_bytes(c);
+        }
+    }
+    return p + m_header;
+}
+
+void*
+CArena::alloc_protected (std::size_t nbytes, [[maybe_unused]] bool cached)
+{
     nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
 
     MemStat* stat = nullptr;
 #ifdef AMREX_TINY_PROFILING
     if (m_do_profiling) {
-        stat = TinyProfiler::memory_alloc(nbytes, m_profiling_stats);
+        if (cached) {
+            // Blocks of the thread caches are reported as a whole, because
+            // they are handed out without the lock.
+            stat = &m_profiling_stats["CArena thread cache"];
+            ++stat->nalloc;
+            stat->currentmem += static_cast<Long>(nbytes);
+            stat->avgmem -= static_cast<double>(nbytes) * amrex::second();
+            stat->maxmem = std::max(stat->maxmem, stat->currentmem);
+        } else {
+            stat = TinyProfiler::memory_alloc(nbytes, m_profiling_stats);
+        }
     }
 #endif
 
@@ -71,7 +155,11 @@ CArena::alloc (std::size_t nbytes)
 
     if (free_it == m_freelist.end())
     {
-        const std::size_t N = nbytes < m_hunk ? m_hunk : nbytes;
+        //
+        // Pages are mapped whole, so a huge page larger than the hunk is
+        // used up rather than wasted.
+        //
+        const std::size_t N = system_alloc_size(nbytes < m_hunk ? m_hunk : nbytes);
 
         vp = allocate_system(N);
 
@@ -79,7 +167,7 @@ CArena::alloc (std::size_t nbytes)
 
         m_alloc.emplace_back(std::make_pair(vp,N));
 
-        if (nbytes < m_hunk)
+        if (nbytes < N)
         {
             //
             // Add leftover chunk to free list.
@@ -88,7 +176,7 @@ CArena::alloc (std::size_t nbytes)
             //
             void* block = static_cast<char*>(vp) + nbytes;
 
-            m_freelist.insert(m_freelist.end(), Node(block, vp, m_hunk-nbytes));
+            m_freelist.insert(m_freelist.end(), Node(block, vp, N-nbytes));
         }
 
         m_busylist.insert(Node(vp, vp, nbytes, stat));
@@ -137,8 +225,34 @@ CArena::free (void* vp)
         return;
     }
 
-    std::lock_guard<std::mutex> lock(carena_mutex);
+    if (m_thread_cache.empty()) {
+        std::lock_guard<std::mutex> lock(carena_mutex);
+        free_protected(vp);
+        return;
+    }
+
+    char* p = static_cast<char*>(vp) - m_header;
+    int c;
+    std::memcpy(&c, p, sizeof(int));
+    ThreadCache* tc = (c >= 0) ? threadCache() : nullptr;
+    if (tc == nullptr) {
+        std::lock_guard<std::mutex> lock(carena_mutex);
+        free_protected(p);
+    } else {
+        tc->bins[c].push_back(p);
+        tc->bytes += class_bytes(c);
+        if (tc->bytes > m_thread_cache_bytes) {
+            ++tc->returns;
+            std::lock_guard<std::mutex> lock(carena_mutex);
+            trimThreadCache_protected(static_cast<int>(tc-m_thread_cache.data()),
+                                      m_thread_cache_bytes/2);
+        }
+    }
+}
 
+void
+CArena::free_protected (void* vp)
+{
     //
     // `vp' had better be in the busy list.
     //
@@ -217,10 +331,51 @@ CArena::free (void* vp)
     }
 }
 
+CArena::ThreadCache*
+CArena::threadCache () noexcept
+{
+#ifdef AMREX_USE_OMP
+    // Nested parallel regions would share the thread numbers.
+    if (omp_in_parallel() && omp_get_level() == 1) {
+        const int tid = omp_get_thread_num();
+        if (tid < static_cast<int>(m_thread_cache.size())) {
+            return &m_thread_cache[tid];
+        }
+    }
+#endif
+    return nullptr;
+}
+
+void
+CArena::trimThreadCache_protected (int tid, std::size_t nbytes)
+{
+    auto& tc = m_thread_cache[tid];
+    for (int c = NumSizeClasses-1; c >= 0 && tc.bytes > nbytes; --c) {
+        auto& bin = tc.bins[c];
+        while (!bin.empty() && tc.bytes > nbytes) {
+            free_protected(bin.back());
+            bin.pop_back();
+            tc.bytes -= class_bytes(c);
+        }
+    }
+}
+
+void
+CArena::flushThreadCaches_protected ()
+{
+    for (int tid = 0; tid < static_cast<int>(m_thread_cache.size()); ++tid) {
+        trimThreadCache_protected(tid, 0);
+    }
+}
+
 std::size_t
 CArena::freeUnused ()
 {
     std::lock_guard<std::mutex> lock(carena_mutex);
+    // The caches of other threads cannot be touched in a parallel region.
+    if (!OpenMP::in_parallel()) {
+        flushThreadCaches_protected();
+    }
     return freeUnused_protected();
 }
 
@@ -315,11 +470,11 @@ CArena::sizeOf (void* p) const noexcept
     if (p == nullptr) {
         return 0;
     } else {
-        auto it = m_busylist.find(Node(p,nullptr,0));
+        auto it = m_busylist.find(Node(static_cast<char*>(p)-m_header,nullptr,0));
         if (it == m_busylist.end()) {
             return 0;
         } else {
-            return it->size();
+            return it->size() - m_header;
         }
     }
 }
@@ -345,6 +500,17 @@ CArena::PrintUsage (std::string const& name) const
     amrex::Print() << "[" << name << "] space allocated (MB): " << min_megabytes << "\n";
     amrex::Print() << "[" << name << "] space used      (MB): " << actual_min_megabytes << "\n";
 #endif
+    if (!m_thread_cache.empty()) {
+        Long hits = 0, misses = 0, returns = 0;
+        for (auto const& tc : m_thread_cache) {
+            hits += tc.hits;
+            misses += tc.misses;
+            returns += tc.returns;
+        }
+        ParallelReduce::Sum<Long>({hits, misses, returns}, IOProc, ParallelDescriptor::Communicator());
+        amrex::Print() << "[" << name << "] thread caches: " << hits << " hits, "
+                       << misses << " misses, " << returns << " batch returns\n";
+    }
 }
 
 void
@@ -356,6 +522,19 @@ CArena::PrintUsage (std::ostream& os, std::string const& name, std::string const
     os << space << "[" << name << "] space used      (MB): " << actual_megabytes << "\n";
     os << space << "[" << name << "]: " << m_alloc.size() << " allocs, "
        << m_busylist.size() << " busy blocks, " << m_freelist.size() << " free blocks\n";
+    if (!m_thread_cache.empty()) {
+        Long hits = 0, misses = 0, returns = 0;
+        std::size_t bytes = 0;
+        for (auto const& tc : m_thread_cache) {
+            hits += tc.hits;
+            misses += tc.misses;
+            returns += tc.returns;
+            bytes += tc.bytes;
+        }
+        os << space << "[" << name << "] thread caches: " << hits << " hits, "
+           << misses << " misses, " << returns << " batch returns, "
+           << bytes/1024 << " KB cached\n";
+    }
 }
 
 }
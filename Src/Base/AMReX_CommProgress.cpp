@@ -0,0 +1,185 @@
+#include <AMReX_CommProgress.H>
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace amrex::CommProgress {
+
+namespace {
+
+    bool s_use_thread = false;
+    bool s_enabled = false;
+    bool s_initialized = false;
+
+#ifdef BL_USE_MPI
+
+    std::unique_ptr<std::thread> s_thread;
+    std::mutex s_mutx;
+    std::condition_variable s_job_cond;
+    std::condition_variable s_done_cond;
+    Vector<std::shared_ptr<Job> > s_jobs;
+    bool s_finalizing = false;
+
+    // Returns true if all the requests of job have completed.
+    bool progress (Job& job)
+    {
+        auto& rreqs = *job.recv_reqs;
+        const auto nr = static_cast<int>(rreqs.size());
+        if (nr > 0) {
+            Vector<int> indices(nr);
+            Vector<MPI_Status> stats(nr);
+            int outcount = 0;
+            BL_MPI_REQUIRE( MPI_Testsome(nr, rreqs.data(), &outcount, indices.data(),
+                                         stats.data()) );
+            if (outcount != MPI_UNDEFINED) {
+                for (int i = 0; i < outcount; ++i) {
+                    if (job.recv_stat) { (*job.recv_stat)[indices[i]] = stats[i]; }
+                    if (job.on_recv) { job.on_recv(indices[i]); }
+                }
+                return false;
+            }
+        }
+
+        // The receives are done, so the sends should be too.
+        int flag = 1;
+        auto& sreqs = *job.send_reqs;
+        if (!sreqs.empty()) {
+            BL_MPI_REQUIRE( MPI_Testall(static_cast<int>(sreqs.size()), sreqs.data(), &flag,
+                                        MPI_STATUSES_IGNORE) );
+        }
+        return flag != 0;
+    }
+
+    void do_jobs ()
+    {
+        while (true)
+        {
+            std::unique_lock<std::mutex> lck(s_mutx);
+            s_job_cond.wait(lck, [] () -> bool { return s_finalizing || !s_jobs.empty(); });
+            if (s_jobs.empty()) { break; } // finalizing
+            auto jobs = s_jobs;
+            lck.unlock();
+
+            Vector<Job*> finished;
+            for (auto const& job : jobs) {
+                if (progress(*job)) { finished.push_back(job.get()); }
+            }
+
+            if (finished.empty()) {
+                std::this_thread::yield();
+            } else {
+                lck.lock();
+                for (auto* job : finished) {
+                    job->done = true;
+                }
+                s_jobs.erase(std::remove_if(s_jobs.begin(), s_jobs.end(),
+                                            [] (auto const& job) { return job->done; }),
+                             s_jobs.end());
+                lck.unlock();
+                s_done_cond.notify_all();
+            }
+        }
+    }
+
+#endif
+}
+
+void
+Initialize ()
+{
+    if (s_initialized) { return; }
+    s_initialized = true;
+
+    s_use_thread = false;
+    ParmParse pp("fabarray");
+    pp.queryAdd("comm_progress_thread", s_use_thread);
+
+    s_enabled = false;
+#ifdef BL_USE_MPI
+    if (s_use_thread) {
+        int provided = MPI_THREAD_SINGLE;
+        MPI_Query_thread(&provided);
+        if (provided < MPI_THREAD_MULTIPLE) {
+            if (ParallelDescriptor::IOProcessor()) {
+                amrex::Warning("fabarray.comm_progress_thread needs MPI_THREAD_MULTIPLE, but MPI provides "
+                               + ParallelDescriptor::mpi_level_to_string(provided)
+                               + ", so the progress thread is off");
+            }
+        } else {
+            s_enabled = true;
+        }
+    }
+#endif
+}
+
+void
+Finalize ()
+{
+#ifdef BL_USE_MPI
+    if (s_thread) {
+        {
+            std::lock_guard<std::mutex> lck(s_mutx);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(s_jobs.empty(),
+                "CommProgress::Finalize: communication still in progress");
+            s_finalizing = true;
+        }
+        s_job_cond.notify_one();
+        s_thread->join();
+        s_thread.reset();
+        s_finalizing = false;
+    }
+#endif
+    s_enabled = false;
+    s_initialized = false;
+}
+
+bool
+Enabled ()
+{
+    return s_enabled;
+}
+
+std::shared_ptr<Job>
+Submit (Vector<MPI_Request>& recv_reqs, Vector<MPI_Status>& recv_stat,
+        Vector<MPI_Request>& send_reqs, std::function<void(int)>&& on_recv)
+{
+    AMREX_ALWAYS_ASSERT(s_enabled);
+
+    auto job = std::make_shared<Job>();
+    job->recv_reqs = &recv_reqs;
+    job->recv_stat = recv_stat.empty() ? nullptr : &recv_stat;
+    job->send_reqs = &send_reqs;
+    job->on_recv = std::move(on_recv);
+
+#ifdef BL_USE_MPI
+    {
+        std::lock_guard<std::mutex> lck(s_mutx);
+        if (!s_thread) {
+            s_thread = std::make_unique<std::thread>(do_jobs);
+        }
+        s_jobs.push_back(job);
+    }
+    s_job_cond.notify_one();
+#endif
+
+    return job;
+}
+
+void
+Wait (Job& job)
+{
+#ifdef BL_USE_MPI
+    std::unique_lock<std::mutex> lck(s_mutx);
+    s_done_cond.wait(lck, [&] () -> bool { return job.done; });
+#else
+    amrex::ignore_unused(job);
+#endif
+}
+
+}
@@ -9,6 +9,7 @@
 #include <AMReX_VisMF.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Morton.H>
+#include <AMReX_Machine.H>
 
 #include <iostream>
 #include <fstream>
@@ -18,6 +19,8 @@
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <set>
+#include <tuple>
 #include <numeric>
 #include <string>
 #include <cstring>
@@ -25,6 +28,10 @@
 
 namespace {
 int flag_verbose_mapper;
+int topology_aware;
+int topology_ngrow;
+int graph_ngrow;
+amrex::Real graph_imbalance;
 }
 
 namespace amrex {
@@ -74,6 +81,12 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case HILBERT:
+        m_BuildMap = &DistributionMapping::SFCProcessorMap;
+        break;
+    case GRAPH:
+        m_BuildMap = &DistributionMapping::GraphProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -115,6 +128,10 @@ DistributionMapping::Initialize ()
     max_efficiency   = 0.9_rt;
     node_size        = 0;
     flag_verbose_mapper = 0;
+    topology_aware   = 0;
+    topology_ngrow   = 1;
+    graph_ngrow      = 1;
+    graph_imbalance  = 0.03_rt;
 
     ParmParse pp("DistributionMapping");
 
@@ -124,6 +141,10 @@ DistributionMapping::Initialize ()
     pp.queryAdd("sfc_threshold",       sfc_threshold);
     pp.queryAdd("node_size",           node_size);
     pp.queryAdd("verbose_mapper",      flag_verbose_mapper);
+    pp.queryAdd("topology_aware",      topology_aware);
+    pp.queryAdd("topology_ngrow",      topology_ngrow);
+    pp.queryAdd("graph_ngrow",         graph_ngrow);
+    pp.queryAdd("graph_imbalance",     graph_imbalance);
 
     std::string theStrategy;
 
@@ -145,6 +166,14 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "HILBERT")
+        {
+            strategy(HILBERT);
+        }
+        else if (theStrategy == "GRAPH")
+        {
+            strategy(GRAPH);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -345,6 +374,10 @@ DistributionMapping::define (const BoxArray& boxes,
     BL_ASSERT(m_BuildMap != nullptr);
 
     (this->*m_BuildMap)(boxes,nprocs);
+
+    if (topology_aware) {
+        TopologyRemap(boxes);
+    }
 }
 
 void
@@ -1042,6 +1075,101 @@ DistributionMapping::KnapSackProcessorMap (const DistributionMapping& olddm,
     }
 }
 
+void
+DistributionMapping::IncrementalProcessorMap (const DistributionMapping& olddm,
+                                              const std::vector<Long>& wgts,
+                                              const std::vector<Long>& bytes,
+                                              Real target_efficiency,
+                                              Real& old_efficiency, Real& new_efficiency,
+                                              Long& moved_bytes)
+{
+    BL_PROFILE("DistributionMapping::IncrementalProcessorMap()");
+
+    const int nprocs = ParallelContext::NProcsSub();
+    const int N = static_cast<int>(wgts.size());
+    BL_ASSERT(N == olddm.size() && N == static_cast<int>(bytes.size()));
+
+    // The boxes move between the ranks of the current communicator.
+    Vector<int> oldpmap(N);
+    ParallelContext::global_to_local_rank(oldpmap.data(), olddm.ProcessorMap().data(), N);
+    Vector<int> pmap = oldpmap;
+
+    Vector<Long> load(nprocs, 0);
+    Vector<Vector<int> > rank_boxes(nprocs);
+    Long sum_weight = 0;
+    for (int i = 0; i < N; ++i) {
+        BL_ASSERT(pmap[i] >= 0 && pmap[i] < nprocs);
+        load[pmap[i]] += wgts[i];
+        rank_boxes[pmap[i]].push_back(i);
+        sum_weight += wgts[i];
+    }
+    const Real avg_weight = static_cast<Real>(sum_weight) / static_cast<Real>(nprocs);
+    const Long old_max_load = *std::max_element(load.begin(), load.end());
+    old_efficiency = (old_max_load > 0) ? avg_weight / static_cast<Real>(old_max_load) : Real(1);
+
+    // (load, rank), with the least loaded first
+    std::set<std::pair<Long,int> > order;
+    for (int iproc = 0; iproc < nprocs; ++iproc) {
+        order.emplace(load[iproc], iproc);
+    }
+
+    // Each move lowers the sorted loads, so this ends; the cap is a guard.
+    for (int nmoves = 0; nmoves < 2*N; ++nmoves)
+    {
+        const auto [wmax, pmax] = *order.rbegin();
+        const auto [wmin, pmin] = *order.begin();
+        if (wmax == 0 || avg_weight / static_cast<Real>(wmax) >= target_efficiency) { break; }
+
+        // The box of pmax that lowers the maximum the most per byte.
+        // Moving a box back to its old rank costs nothing.
+        int best = -1;
+        Real best_score = 0;
+        auto& boxes = rank_boxes[pmax];
+        for (int k = 0, nk = static_cast<int>(boxes.size()); k < nk; ++k) {
+            const int i = boxes[k];
+            if (wgts[i] <= 0 || wmin + wgts[i] >= wmax) { continue; }
+            const Long gain = wmax - std::max(wmax - wgts[i], wmin + wgts[i]);
+            const Long cost = (oldpmap[i] == pmin) ? 0 : ((oldpmap[i] == pmax) ? bytes[i] : 0);
+            const Real score = static_cast<Real>(gain) / static_cast<Real>(cost+1);
+            if (score > best_score) {
+                best = k;
+                best_score = score;
+            }
+        }
+        if (best < 0) { break; }
+
+        const int i = boxes[best];
+        boxes[best] = boxes.back();
+        boxes.pop_back();
+        rank_boxes[pmin].push_back(i);
+        pmap[i] = pmin;
+
+        order.erase(order.begin());
+        order.erase(std::prev(order.end()));
+        load[pmax] -= wgts[i];
+        load[pmin] += wgts[i];
+        order.emplace(load[pmax], pmax);
+        order.emplace(load[pmin], pmin);
+    }
+
+    const Long max_load = order.rbegin()->first;
+    new_efficiency = (max_load > 0) ? avg_weight / static_cast<Real>(max_load) : Real(1);
+
+    moved_bytes = 0;
+    for (int i = 0; i < N; ++i) {
+        if (pmap[i] != oldpmap[i]) { moved_bytes += bytes[i]; }
+    }
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(N);
+    ParallelContext::local_to_global_rank(m_ref->m_pmap.data(), pmap.data(), N);
+
+    if (verbose) {
+        amrex::Print() << "Incremental rebalance: efficiency " << old_efficiency << " -> "
+                       << new_efficiency << ", moving " << moved_bytes << " bytes\n";
+    }
+}
+
 void
 DistributionMapping::KnapSackProcessorMap (const BoxArray& boxes,
                                            int             nprocs)
@@ -1169,6 +1297,104 @@ namespace {
 
         return token;
     }
+
+    // Index of the nbits-bit point x along the Hilbert curve, by Skilling's
+    // algorithm (AIP Conf. Proc. 707, 381, 2004).
+    uint64_t hilbertIndex (Array<uint32_t,AMREX_SPACEDIM> x, int nbits)
+    {
+        constexpr int n = AMREX_SPACEDIM;
+        const uint32_t M = 1U << (nbits-1);
+        // Inverse undo
+        for (uint32_t Q = M; Q > 1; Q >>= 1) {
+            const uint32_t P = Q - 1;
+            for (int i = 0; i < n; ++i) {
+                if (x[i] & Q) {
+                    x[0] ^= P;
+                } else {
+                    const uint32_t t = (x[0] ^ x[i]) & P;
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+        // Gray encode
+        for (int i = 1; i < n; ++i) {
+            x[i] ^= x[i-1];
+        }
+        uint32_t t = 0;
+        for (uint32_t Q = M; Q > 1; Q >>= 1) {
+            if (x[n-1] & Q) { t ^= Q - 1; }
+        }
+        for (int i = 0; i < n; ++i) {
+            x[i] ^= t;
+        }
+        // Interleave the bits, most significant first.
+        uint64_t h = 0;
+        for (int b = nbits-1; b >= 0; --b) {
+            for (int i = 0; i < n; ++i) {
+                h = (h << 1) | ((x[i] >> b) & 1U);
+            }
+        }
+        return h;
+    }
+
+    // Tokens of the boxes keyed by the Hilbert index of their small ends,
+    // so that they sort with SFCToken::Compare.  The index has at most 64
+    // bits, so the coordinates are coarsened if the boxes span too far.
+    std::vector<SFCToken> makeHilbertTokens (const BoxArray& boxes)
+    {
+        const int N = static_cast<int>(boxes.size());
+        const Box& b0 = boxes[0];
+        IntVect lo = b0.smallEnd();
+        IntVect hi = lo;
+        for (int i = 1; i < N; ++i) {
+            const Box& bx = boxes[i];
+            lo.min(bx.smallEnd());
+            hi.max(bx.smallEnd());
+        }
+        Long range = 0;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            range = std::max(range, Long(hi[d]) - Long(lo[d]));
+        }
+        int nbits = 1;
+        while (nbits < 32 && (Long(1) << nbits) <= range) { ++nbits; }
+        constexpr int maxbits = std::min(64/AMREX_SPACEDIM, 32);
+        const int shift = std::max(nbits-maxbits, 0);
+        nbits -= shift;
+
+        std::vector<SFCToken> tokens(N);
+        for (int i = 0; i < N; ++i)
+        {
+            const Box& bx = boxes[i];
+            const IntVect& iv = bx.smallEnd();
+            Array<uint32_t,AMREX_SPACEDIM> x;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                x[d] = static_cast<uint32_t>(Long(iv[d]) - Long(lo[d])) >> shift;
+            }
+            const uint64_t h = hilbertIndex(x, nbits);
+            tokens[i].m_box = i;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                tokens[i].m_morton[d] = (d < 2) ? static_cast<uint32_t>(h >> (32*d)) : 0U;
+            }
+        }
+        return tokens;
+    }
+
+    std::vector<SFCToken> makeSFCTokens (const BoxArray& boxes, bool hilbert)
+    {
+        if (hilbert) {
+            return makeHilbertTokens(boxes);
+        }
+        const int N = static_cast<int>(boxes.size());
+        std::vector<SFCToken> tokens;
+        tokens.reserve(N);
+        for (int i = 0; i < N; ++i)
+        {
+            const Box& bx = boxes[i];
+            tokens.push_back(makeSFCToken(i, bx.smallEnd()));
+        }
+        return tokens;
+    }
 }
 
 static
@@ -1255,6 +1481,76 @@ Distribute (const std::vector<SFCToken>&     tokens,
 #endif
 }
 
+//
+// Cut the sorted tokens into nprocs contiguous chains such that the
+// heaviest chain is as light as possible.  The bottleneck weight is found
+// by bisection, testing each candidate by greedily filling the chains with
+// binary searches of the prefix sums.
+//
+static
+void
+DistributeChains (const std::vector<SFCToken>&     tokens,
+                  const std::vector<Long>&         wgts,
+                  int                              nprocs,
+                  std::vector< std::vector<int> >& v)
+{
+    BL_PROFILE("DistributionMapping::DistributeChains()");
+
+    BL_ASSERT(static_cast<int>(v.size()) == nprocs);
+
+    const int N = static_cast<int>(tokens.size());
+    std::vector<Long> psum(N+1, 0);
+    Long wmax = 0;
+    for (int i = 0; i < N; ++i) {
+        const Long w = wgts[tokens[i].m_box];
+        psum[i+1] = psum[i] + w;
+        wmax = std::max(wmax, w);
+    }
+
+    // Fill the chains with at most B each, keeping at least one token for
+    // each chain left.  Returns whether all the tokens fit.
+    auto fill = [&] (Long B, std::vector<int>* ends) -> bool
+    {
+        int start = 0;
+        for (int p = 0; p < nprocs; ++p) {
+            int end = static_cast<int>(std::upper_bound(psum.begin()+start, psum.end(),
+                                                        psum[start]+B) - psum.begin()) - 1;
+            end = std::max(start, std::min(end, N-(nprocs-1-p)));
+            if (ends) { ends->push_back(end); }
+            start = end;
+        }
+        return start == N;
+    };
+
+    const Long avg = (psum[N] + nprocs - 1) / nprocs;
+    Long lo = std::max(wmax, avg);
+    Long hi = avg + wmax;
+    while (lo < hi) {
+        const Long mid = lo + (hi-lo)/2;
+        if (fill(mid, nullptr)) {
+            hi = mid;
+        } else {
+            lo = mid+1;
+        }
+    }
+
+    std::vector<int> ends;
+    ends.reserve(nprocs);
+    fill(lo, &ends);
+
+    int start = 0;
+    for (int p = 0; p < nprocs; ++p) {
+        for (int k = start; k < ends[p]; ++k) {
+            v[p].push_back(tokens[k].m_box);
+        }
+        start = ends[p];
+    }
+
+    if (flag_verbose_mapper) {
+        Print() << "DistributeChains: bottleneck " << lo << ", average " << avg << std::endl;
+    }
+}
+
 void
 DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
                                           const std::vector<Long>& wgts,
@@ -1291,16 +1587,12 @@ DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
                 << nprocs << ", " << nteams << ", " << nworkers << ")\n";
     }
 
+    const bool hilbert = (m_Strategy == HILBERT);
+
     const int N = static_cast<int>(boxes.size());
-    std::vector<SFCToken> tokens;
-    tokens.reserve(N);
-    for (int i = 0; i < N; ++i)
-    {
-        const Box& bx = boxes[i];
-        tokens.push_back(makeSFCToken(i, bx.smallEnd()));
-    }
+    std::vector<SFCToken> tokens = makeSFCTokens(boxes, hilbert);
     //
-    // Put'm in Morton space filling curve order.
+    // Put'm in Morton or Hilbert space filling curve order.
     //
     std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
     //
@@ -1314,7 +1606,11 @@ DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
 
     std::vector< std::vector<int> > vec(nteams);
 
-    Distribute(tokens,wgts,nteams,volperteam,vec);
+    if (hilbert) {
+        DistributeChains(tokens,wgts,nteams,vec);
+    } else {
+        Distribute(tokens,wgts,nteams,volperteam,vec);
+    }
 
     // vec has a size of nteams and vec[] holds a vector of box ids.
 
@@ -1449,7 +1745,9 @@ DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
 
         if (verbose)
         {
-            amrex::Print() << "SFC efficiency: " << efficiency << '\n';
+            amrex::Print() << (hilbert ? "Hilbert" : "SFC") << " efficiency: " << efficiency
+                           << ", off-rank halo cells: "
+                           << OffRankHaloCells(boxes, IntVect(topology_ngrow)) << '\n';
         }
     }
 }
@@ -1501,6 +1799,10 @@ DistributionMapping::SFCProcessorMap (const BoxArray&          boxes,
     {
         SFCProcessorMapDoIt(boxes,wgts,nprocs,sort);
     }
+
+    if (topology_aware) {
+        TopologyRemap(boxes);
+    }
 }
 
 void
@@ -1524,6 +1826,774 @@ DistributionMapping::SFCProcessorMap (const BoxArray&          boxes,
     {
         SFCProcessorMapDoIt(boxes,wgts,nprocs,sort,&eff);
     }
+
+    if (topology_aware) {
+        TopologyRemap(boxes);
+    }
+}
+
+namespace {
+
+    // Number of ghost cells of width ng shared by the ranks of each pair of
+    // boxes.  owner is the local rank of each box.
+    Vector<std::map<int,Long> >
+    halo_graph (const BoxArray& boxes, Vector<int> const& owner, int nranks, const IntVect& ng)
+    {
+        Vector<std::map<int,Long> > w(nranks);
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0, N = static_cast<int>(boxes.size()); i < N; ++i)
+        {
+            boxes.intersections(amrex::grow(boxes[i],ng), isects);
+            for (auto const& is : isects) {
+                const int a = owner[i];
+                const int b = owner[is.first];
+                if (is.first != i && a != b) {
+                    const Long v = is.second.numPts();
+                    w[a][b] += v;
+                    w[b][a] += v;
+                }
+            }
+        }
+        return w;
+    }
+
+    // Split the buckets into groups of the given sizes, adding to each group
+    // the bucket with the most halo shared with the group so far.
+    Vector<Vector<int> >
+    group_buckets (Vector<int> const& buckets, Vector<int> const& group_size,
+                   Vector<std::map<int,Long> > const& w)
+    {
+        std::map<int,Long> conn;
+        std::set<std::pair<Long,int> > order; // (-conn, bucket)
+        std::set<int> free(buckets.begin(), buckets.end());
+
+        Vector<Vector<int> > groups(group_size.size());
+        for (int g = 0, ng = static_cast<int>(group_size.size()); g < ng; ++g)
+        {
+            conn.clear();
+            order.clear();
+            while (static_cast<int>(groups[g].size()) < group_size[g] && !free.empty())
+            {
+                int b;
+                if (order.empty()) {
+                    b = *free.begin();
+                } else {
+                    b = order.begin()->second;
+                    order.erase(order.begin());
+                }
+                free.erase(b);
+                groups[g].push_back(b);
+                for (auto const& [nb, v] : w[b]) {
+                    if (free.count(nb) == 0) { continue; }
+                    auto& c = conn[nb];
+                    order.erase({-c, nb});
+                    c += v;
+                    order.emplace(-c, nb);
+                }
+            }
+        }
+        return groups;
+    }
+}
+
+void
+DistributionMapping::TopologyRemap (const BoxArray& boxes)
+{
+    BL_PROFILE("DistributionMapping::TopologyRemap()");
+
+    const int nprocs = ParallelContext::NProcsSub();
+    auto const& node_of_rank = machine::node_of_rank();
+    auto const& socket_of_rank = machine::socket_of_rank();
+
+    // The local ranks on each node and socket, in the order of their first rank.
+    std::map<int,std::map<int,Vector<int> > > node_ranks;
+    Vector<int> node_order;
+    for (int r = 0; r < nprocs; ++r) {
+        const int g = ParallelContext::local_to_global_rank(r);
+        const int node = node_of_rank[g];
+        if (node_ranks.count(node) == 0) { node_order.push_back(node); }
+        node_ranks[node][socket_of_rank[g]].push_back(r);
+    }
+    if (node_order.size() == 1 && node_ranks.begin()->second.size() == 1) { return; }
+
+    IntVect ng(topology_ngrow);
+    Real before = verbose ? InterNodeHaloFraction(boxes, ng) : Real(0);
+
+    auto& pmap = m_ref->m_pmap;
+    Vector<int> owner(pmap.size());
+    for (int i = 0, N = static_cast<int>(pmap.size()); i < N; ++i) {
+        owner[i] = ParallelContext::global_to_local_rank(pmap[i]);
+    }
+
+    auto w = halo_graph(boxes, owner, nprocs, ng);
+
+    // The buckets are the boxes of each rank of the original mapping.
+    Vector<int> buckets(nprocs);
+    std::iota(buckets.begin(), buckets.end(), 0);
+
+    Vector<int> node_nranks;
+    for (int node : node_order) {
+        int n = 0;
+        for (auto const& kv : node_ranks[node]) { n += static_cast<int>(kv.second.size()); }
+        node_nranks.push_back(n);
+    }
+    auto node_groups = group_buckets(buckets, node_nranks, w);
+
+    Vector<int> newrank(nprocs);
+    for (int in = 0, nn = static_cast<int>(node_order.size()); in < nn; ++in)
+    {
+        auto const& sockets = node_ranks[node_order[in]];
+        Vector<int> socket_nranks;
+        for (auto const& kv : sockets) {
+            socket_nranks.push_back(static_cast<int>(kv.second.size()));
+        }
+        auto socket_groups = group_buckets(node_groups[in], socket_nranks, w);
+        int is = 0;
+        for (auto const& kv : sockets) {
+            auto const& ranks = kv.second;
+            for (int k = 0, nk = static_cast<int>(ranks.size()); k < nk; ++k) {
+                newrank[socket_groups[is][k]] = ranks[k];
+            }
+            ++is;
+        }
+    }
+
+    for (int i = 0, N = static_cast<int>(pmap.size()); i < N; ++i) {
+        pmap[i] = ParallelContext::local_to_global_rank(newrank[owner[i]]);
+    }
+
+    if (verbose) {
+        amrex::Print() << "DistributionMapping::TopologyRemap: inter-node halo fraction "
+                       << before << " -> " << InterNodeHaloFraction(boxes, ng) << '\n';
+    }
+}
+
+Real
+DistributionMapping::InterNodeHaloFraction (const BoxArray& boxes, const IntVect& ngrow) const
+{
+    auto const& node_of_rank = machine::node_of_rank();
+    auto const& pmap = m_ref->m_pmap;
+
+    Long total = 0, internode = 0;
+    std::vector<std::pair<int,Box> > isects;
+    for (int i = 0, N = static_cast<int>(boxes.size()); i < N; ++i)
+    {
+        boxes.intersections(amrex::grow(boxes[i],ngrow), isects);
+        for (auto const& is : isects) {
+            if (is.first != i) {
+                const Long v = is.second.numPts();
+                total += v;
+                if (node_of_rank[pmap[i]] != node_of_rank[pmap[is.first]]) {
+                    internode += v;
+                }
+            }
+        }
+    }
+    return (total > 0) ? static_cast<Real>(internode)/static_cast<Real>(total) : Real(0);
+}
+
+Long
+DistributionMapping::OffRankHaloCells (const BoxArray& boxes, const IntVect& ngrow) const
+{
+    auto const& pmap = m_ref->m_pmap;
+
+    Long offrank = 0;
+    std::vector<std::pair<int,Box> > isects;
+    for (int i = 0, N = static_cast<int>(boxes.size()); i < N; ++i)
+    {
+        boxes.intersections(amrex::grow(boxes[i],ngrow), isects);
+        for (auto const& is : isects) {
+            if (is.first != i && pmap[i] != pmap[is.first]) {
+                offrank += is.second.numPts();
+            }
+        }
+    }
+    return offrank;
+}
+
+namespace {
+
+    // A graph in compressed sparse row form.
+    struct CSRGraph
+    {
+        std::vector<Long> vwgt;
+        std::vector<int>  xadj{0};
+        std::vector<int>  adjncy;
+        std::vector<Long> adjwgt;
+        //! Twice the center of each box.  Only the graph of the boxes has it.
+        std::vector<IntVect> center;
+
+        [[nodiscard]] int size () const { return static_cast<int>(vwgt.size()); }
+    };
+
+    // The boxes weighted by wgts, with an edge between two boxes weighted
+    // by the number of ghost cells of width ng they fill for each other.
+    CSRGraph
+    box_graph (const BoxArray& boxes, const std::vector<Long>& wgts, const IntVect& ng)
+    {
+        const int N = static_cast<int>(boxes.size());
+        Vector<std::map<int,Long> > nbrs(N);
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0; i < N; ++i)
+        {
+            boxes.intersections(amrex::grow(boxes[i],ng), isects);
+            for (auto const& is : isects) {
+                if (is.first != i) {
+                    const Long v = is.second.numPts();
+                    nbrs[i][is.first] += v;
+                    nbrs[is.first][i] += v;
+                }
+            }
+        }
+
+        CSRGraph g;
+        g.vwgt = wgts;
+        g.center.reserve(N);
+        for (int i = 0; i < N; ++i) {
+            const Box& bx = boxes[i];
+            g.center.push_back(bx.smallEnd() + bx.bigEnd());
+            for (auto const& [j, v] : nbrs[i]) {
+                g.adjncy.push_back(j);
+                g.adjwgt.push_back(v);
+            }
+            g.xadj.push_back(static_cast<int>(g.adjncy.size()));
+        }
+        return g;
+    }
+
+    // The subgraph of g made of verts.
+    CSRGraph
+    sub_graph (const CSRGraph& g, const std::vector<int>& verts)
+    {
+        std::vector<int> local(g.size(), -1);
+        for (int k = 0, n = static_cast<int>(verts.size()); k < n; ++k) {
+            local[verts[k]] = k;
+        }
+
+        CSRGraph s;
+        s.vwgt.reserve(verts.size());
+        s.center.reserve(verts.size());
+        for (int u : verts) {
+            s.vwgt.push_back(g.vwgt[u]);
+            s.center.push_back(g.center[u]);
+            for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                const int v = local[g.adjncy[k]];
+                if (v >= 0) {
+                    s.adjncy.push_back(v);
+                    s.adjwgt.push_back(g.adjwgt[k]);
+                }
+            }
+            s.xadj.push_back(static_cast<int>(s.adjncy.size()));
+        }
+        return s;
+    }
+
+    // Coarsen g by matching each vertex with the unmatched neighbor it
+    // shares the heaviest edge with, without making vertices heavier than
+    // maxvwgt.  cmap is the coarse vertex of each vertex of g.
+    CSRGraph
+    coarsen (const CSRGraph& g, Long maxvwgt, std::vector<int>& cmap)
+    {
+        const int n = g.size();
+
+        // Light vertices first, so that they find a partner.
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&] (int a, int b) { return g.vwgt[a] < g.vwgt[b]; });
+
+        cmap.assign(n, -1);
+        std::vector<std::pair<int,int> > members;
+        for (int u : order)
+        {
+            if (cmap[u] >= 0) { continue; }
+            int best = u;
+            Long bestw = 0;
+            for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                const int v = g.adjncy[k];
+                if (cmap[v] < 0 && v != u && g.adjwgt[k] > bestw
+                    && g.vwgt[u] + g.vwgt[v] <= maxvwgt)
+                {
+                    best = v;
+                    bestw = g.adjwgt[k];
+                }
+            }
+            cmap[u] = cmap[best] = static_cast<int>(members.size());
+            members.emplace_back(u, best);
+        }
+
+        const int nc = static_cast<int>(members.size());
+        CSRGraph c;
+        c.vwgt.reserve(nc);
+        std::vector<Long> acc(nc, 0);
+        std::vector<int> touched;
+        for (int cu = 0; cu < nc; ++cu)
+        {
+            auto const [u0, u1] = members[cu];
+            c.vwgt.push_back(g.vwgt[u0] + ((u1 != u0) ? g.vwgt[u1] : 0));
+            for (int u : {u0, u1}) {
+                for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                    const int cv = cmap[g.adjncy[k]];
+                    if (cv == cu) { continue; }
+                    if (acc[cv] == 0) { touched.push_back(cv); }
+                    acc[cv] += g.adjwgt[k];
+                }
+                if (u1 == u0) { break; }
+            }
+            for (int cv : touched) {
+                c.adjncy.push_back(cv);
+                c.adjwgt.push_back(acc[cv]);
+                acc[cv] = 0;
+            }
+            touched.clear();
+            c.xadj.push_back(static_cast<int>(c.adjncy.size()));
+        }
+        return c;
+    }
+
+    // A bisection is better if its side 0 is closer to the allowed range
+    // [target0-tol,target0+tol], then if it cuts less, then if it is closer
+    // to target0.
+    struct BisectionScore
+    {
+        Long violation;
+        Long cut;
+        Long imbalance;
+
+        BisectionScore (Long w0, Long a_cut, Long target0, Long tol)
+            : violation(std::max(Long(0), std::abs(w0-target0)-tol)),
+              cut(a_cut),
+              imbalance(std::abs(w0-target0))
+            {}
+
+        bool operator< (const BisectionScore& rhs) const noexcept {
+            return std::tie(violation, cut, imbalance)
+                <  std::tie(rhs.violation, rhs.cut, rhs.imbalance);
+        }
+    };
+
+    Long
+    edge_cut (const CSRGraph& g, const std::vector<int>& where)
+    {
+        Long cut = 0;
+        for (int u = 0, n = g.size(); u < n; ++u) {
+            for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                if (where[g.adjncy[k]] != where[u]) { cut += g.adjwgt[k]; }
+            }
+        }
+        return cut/2;
+    }
+
+    // Fiduccia-Mattheyses refinement of the bisection where.  Each pass
+    // moves every vertex at most once, the one with the highest gain in
+    // edge cut first, and keeps the best prefix of the moves.
+    void
+    fm_refine (const CSRGraph& g, std::vector<int>& where, Long target0, Long tol)
+    {
+        constexpr int max_passes = 8;
+        const int n = g.size();
+        if (n < 2) { return; }
+        const int max_bad_moves = std::max(50, n/10);
+
+        Long w0 = 0;
+        for (int u = 0; u < n; ++u) {
+            if (where[u] == 0) { w0 += g.vwgt[u]; }
+        }
+        Long cut = edge_cut(g, where);
+
+        std::vector<Long> gain(n);
+        std::vector<char> locked(n);
+        std::vector<int> moves;
+        for (int pass = 0; pass < max_passes; ++pass)
+        {
+            std::set<std::pair<Long,int> > queue[2]; // (-gain, vertex)
+            for (int u = 0; u < n; ++u) {
+                Long g_u = 0;
+                for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                    g_u += (where[g.adjncy[k]] != where[u]) ? g.adjwgt[k] : -g.adjwgt[k];
+                }
+                gain[u] = g_u;
+                locked[u] = 0;
+                queue[where[u]].emplace(-g_u, u);
+            }
+            moves.clear();
+
+            Long cur_w0 = w0, cur_cut = cut;
+            BisectionScore best(w0, cut, target0, tol);
+            std::size_t nbest = 0;
+            Long best_w0 = w0, best_cut = cut;
+
+            while (static_cast<int>(moves.size() - nbest) < max_bad_moves)
+            {
+                // The best move from each side that does not make the
+                // balance worse beyond the tolerance.
+                const Long cur_violation = BisectionScore(cur_w0, 0, target0, tol).violation;
+                int umove = -1;
+                for (int s = 0; s < 2; ++s) {
+                    int nlook = 0;
+                    for (auto it = queue[s].begin(); it != queue[s].end() && nlook < 8; ++it, ++nlook) {
+                        const int u = it->second;
+                        const Long new_w0 = (s == 0) ? cur_w0 - g.vwgt[u] : cur_w0 + g.vwgt[u];
+                        const Long v = BisectionScore(new_w0, 0, target0, tol).violation;
+                        if (v == 0 || v < cur_violation) {
+                            if (umove < 0 || gain[u] > gain[umove]) { umove = u; }
+                            break;
+                        }
+                    }
+                }
+                if (umove < 0) { break; }
+
+                const int s = where[umove];
+                queue[s].erase({-gain[umove], umove});
+                locked[umove] = 1;
+                where[umove] = 1-s;
+                cur_cut -= gain[umove];
+                cur_w0 += (s == 0) ? -g.vwgt[umove] : g.vwgt[umove];
+                moves.push_back(umove);
+
+                for (int k = g.xadj[umove]; k < g.xadj[umove+1]; ++k) {
+                    const int v = g.adjncy[k];
+                    if (locked[v]) { continue; }
+                    queue[where[v]].erase({-gain[v], v});
+                    gain[v] += (where[v] == where[umove]) ? -2*g.adjwgt[k] : 2*g.adjwgt[k];
+                    queue[where[v]].emplace(-gain[v], v);
+                }
+
+                BisectionScore score(cur_w0, cur_cut, target0, tol);
+                if (score < best) {
+                    best = score;
+                    nbest = moves.size();
+                    best_w0 = cur_w0;
+                    best_cut = cur_cut;
+                }
+            }
+
+            for (std::size_t i = moves.size(); i > nbest; --i) {
+                where[moves[i-1]] ^= 1;
+            }
+            w0 = best_w0;
+            cut = best_cut;
+
+            if (nbest == 0) { break; }
+        }
+    }
+
+    // Grow side 0 from seed, adding the vertex most connected to it, until
+    // it weighs target0.
+    std::vector<int>
+    grow_bisection (const CSRGraph& g, int seed, Long target0)
+    {
+        const int n = g.size();
+        std::vector<int> where(n, 1);
+        std::vector<Long> conn(n, 0);
+        std::set<std::pair<Long,int> > frontier; // (-conn, vertex)
+        Long w0 = 0;
+        int next_unreached = 0;
+        int u = seed;
+        while (true)
+        {
+            where[u] = 0;
+            w0 += g.vwgt[u];
+            if (w0 >= target0) { break; }
+            for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                const int v = g.adjncy[k];
+                if (where[v] == 0) { continue; }
+                frontier.erase({-conn[v], v});
+                conn[v] += g.adjwgt[k];
+                frontier.emplace(-conn[v], v);
+            }
+            frontier.erase({-conn[u], u});
+            if (!frontier.empty()) {
+                u = frontier.begin()->second;
+            } else {
+                // The rest is not connected to side 0.
+                while (next_unreached < n && where[next_unreached] == 0) { ++next_unreached; }
+                if (next_unreached == n) { break; }
+                u = next_unreached;
+            }
+        }
+        return where;
+    }
+
+    BisectionScore
+    bisection_score (const CSRGraph& g, const std::vector<int>& where, Long target0, Long tol)
+    {
+        Long w0 = 0;
+        for (int u = 0, n = g.size(); u < n; ++u) {
+            if (where[u] == 0) { w0 += g.vwgt[u]; }
+        }
+        return BisectionScore(w0, edge_cut(g, where), target0, tol);
+    }
+
+    // Multilevel bisection of g with side 0 weighing about target0.  The
+    // coarsening cannot see the shape of the boxes, so the result is
+    // compared with the refined cuts across each coordinate direction.
+    std::vector<int>
+    bisect (const CSRGraph& g, Long target0, Long tol)
+    {
+        constexpr int coarsest_size = 32;
+        constexpr int ntries = 4;
+
+        Long total = 0, maxvwgt = 0;
+        for (Long w : g.vwgt) {
+            total += w;
+            maxvwgt = std::max(maxvwgt, w);
+        }
+        maxvwgt = std::max(maxvwgt, total/coarsest_size);
+
+        std::vector<CSRGraph> graphs;
+        std::vector<std::vector<int> > cmaps;
+        const CSRGraph* cg = &g;
+        while (cg->size() > coarsest_size)
+        {
+            std::vector<int> cmap;
+            CSRGraph c = coarsen(*cg, maxvwgt, cmap);
+            if (10*c.size() > 9*cg->size()) { break; }
+            graphs.push_back(std::move(c));
+            cmaps.push_back(std::move(cmap));
+            cg = &graphs.back();
+        }
+
+        // Grow from a few seeds, and keep the best after refinement.
+        std::vector<int> where;
+        const int nc = cg->size();
+        for (int t = 0; t < std::min(ntries, nc); ++t) {
+            auto w = grow_bisection(*cg, static_cast<int>((Long(t)*nc)/ntries), target0);
+            fm_refine(*cg, w, target0, tol);
+            if (where.empty() ||
+                bisection_score(*cg, w, target0, tol) < bisection_score(*cg, where, target0, tol))
+            {
+                where = std::move(w);
+            }
+        }
+
+        // Project back to the finer graphs, refining on the way.
+        for (int lev = static_cast<int>(graphs.size())-1; lev >= 0; --lev)
+        {
+            const CSRGraph& fg = (lev == 0) ? g : graphs[lev-1];
+            auto const& cmap = cmaps[lev];
+            std::vector<int> fwhere(fg.size());
+            for (int u = 0, n = fg.size(); u < n; ++u) {
+                fwhere[u] = where[cmap[u]];
+            }
+            where = std::move(fwhere);
+            fm_refine(fg, where, target0, tol);
+        }
+
+        const int n = g.size();
+        std::vector<int> order(n);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&] (int a, int b)
+                             { return g.center[a][idim] < g.center[b][idim]; });
+            std::vector<int> w(n, 1);
+            Long w0 = 0;
+            for (int k = 0; k < n && w0 < target0; ++k) {
+                w[order[k]] = 0;
+                w0 += g.vwgt[order[k]];
+            }
+            fm_refine(g, w, target0, tol);
+            if (bisection_score(g, w, target0, tol) < bisection_score(g, where, target0, tol)) {
+                where = std::move(w);
+            }
+        }
+
+        return where;
+    }
+
+    // Partition verts, the vertices of g, into nparts parts numbered from
+    // first_part by recursive bisection.  Each level of bisections may make
+    // the parts heavier than the average by level_imbalance.
+    void
+    partition_graph (const CSRGraph& g, const std::vector<int>& verts, int nparts,
+                     int first_part, Real level_imbalance, std::vector<int>& part)
+    {
+        if (nparts == 1 || static_cast<int>(verts.size()) <= 1) {
+            for (int u : verts) { part[u] = first_part; }
+            return;
+        }
+
+        CSRGraph s = sub_graph(g, verts);
+        Long total = 0;
+        for (Long w : s.vwgt) { total += w; }
+
+        const int np0 = nparts/2;
+        const auto target0 = static_cast<Long>(static_cast<double>(total)*np0/nparts);
+        const auto tol = static_cast<Long>(level_imbalance*static_cast<double>(total)*np0/nparts);
+
+        auto where = bisect(s, target0, tol);
+
+        std::vector<int> verts0, verts1;
+        for (int k = 0, n = static_cast<int>(verts.size()); k < n; ++k) {
+            ((where[k] == 0) ? verts0 : verts1).push_back(verts[k]);
+        }
+        partition_graph(g, verts0, np0, first_part, level_imbalance, part);
+        partition_graph(g, verts1, nparts-np0, first_part+np0, level_imbalance, part);
+    }
+
+    // Move each vertex on the boundary of its part to the neighboring part
+    // it shares the most edge weight with, if that lowers the edge cut
+    // without making the heaviest part heavier.  This fixes the cuts that
+    // the recursive bisection could not see across its earlier bisections.
+    void
+    refine_kway (const CSRGraph& g, int nparts, std::vector<int>& part)
+    {
+        constexpr int max_passes = 8;
+        const int n = g.size();
+
+        std::vector<Long> pwgt(nparts, 0);
+        for (int u = 0; u < n; ++u) {
+            pwgt[part[u]] += g.vwgt[u];
+        }
+        const Long maxpwgt = *std::max_element(pwgt.begin(), pwgt.end());
+
+        std::vector<Long> conn(nparts, 0);
+        std::vector<int> touched;
+        for (int pass = 0; pass < max_passes; ++pass)
+        {
+            int nmoved = 0;
+            for (int u = 0; u < n; ++u)
+            {
+                const int p = part[u];
+                for (int k = g.xadj[u]; k < g.xadj[u+1]; ++k) {
+                    const int q = part[g.adjncy[k]];
+                    if (conn[q] == 0) { touched.push_back(q); }
+                    conn[q] += g.adjwgt[k];
+                }
+
+                int best = p;
+                Long best_gain = 0;
+                for (int q : touched) {
+                    const Long gain = conn[q] - conn[p];
+                    if (q != p && pwgt[q] + g.vwgt[u] <= maxpwgt &&
+                        (gain > best_gain || (gain == best_gain && best != p && pwgt[q] < pwgt[best])))
+                    {
+                        best = q;
+                        best_gain = gain;
+                    }
+                }
+                for (int q : touched) { conn[q] = 0; }
+                touched.clear();
+
+                if (best != p) {
+                    part[u] = best;
+                    pwgt[p] -= g.vwgt[u];
+                    pwgt[best] += g.vwgt[u];
+                    ++nmoved;
+                }
+            }
+            if (nmoved == 0) { break; }
+        }
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMapDoIt (const BoxArray&          boxes,
+                                            const std::vector<Long>& wgts,
+                                            int                      nprocs,
+                                            Real*                    eff)
+{
+    BL_PROFILE("DistributionMapping::GraphProcessorMapDoIt()");
+
+    const int N = static_cast<int>(boxes.size());
+    const IntVect ng(graph_ngrow);
+
+    CSRGraph g = box_graph(boxes, wgts, ng);
+
+    std::vector<int> verts(N);
+    std::iota(verts.begin(), verts.end(), 0);
+    int nlevels = 0;
+    while ((1 << nlevels) < nprocs) { ++nlevels; }
+    std::vector<int> part(N);
+    partition_graph(g, verts, nprocs, 0, graph_imbalance/std::max(nlevels,1), part);
+    refine_kway(g, nprocs, part);
+
+    std::vector<LIpair> LIpairV;
+    LIpairV.reserve(nprocs);
+    for (int p = 0; p < nprocs; ++p) {
+        LIpairV.emplace_back(0,p);
+    }
+    for (int i = 0; i < N; ++i) {
+        LIpairV[part[i]].first += wgts[i];
+    }
+
+    Long sum_wgt = 0, max_wgt = 0;
+    for (auto const& p : LIpairV) {
+        sum_wgt += p.first;
+        max_wgt = std::max(max_wgt, p.first);
+    }
+
+    // The heaviest parts go to the least used ranks.
+    Sort(LIpairV, true);
+    Vector<int> ord;
+    LeastUsedCPUs(nprocs, ord);
+    Vector<int> rank_of_part(nprocs);
+    for (int i = 0; i < nprocs; ++i) {
+        rank_of_part[LIpairV[i].second] = ord[i];
+    }
+    for (int i = 0; i < N; ++i) {
+        m_ref->m_pmap[i] = ParallelContext::local_to_global_rank(rank_of_part[part[i]]);
+    }
+
+    Real efficiency = static_cast<Real>(sum_wgt)/static_cast<Real>(nprocs*max_wgt);
+    if (eff) *eff = efficiency;
+
+    if (verbose)
+    {
+        amrex::Print() << "Graph efficiency: " << efficiency
+                       << ", off-rank halo cells: " << OffRankHaloCells(boxes, ng) << '\n';
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray& boxes, int nprocs)
+{
+    BL_ASSERT( ! boxes.empty());
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(boxes.size());
+
+    if (boxes.size() <= nprocs || boxes.size() < sfc_threshold*nprocs)
+    {
+        KnapSackProcessorMap(boxes,nprocs);
+    }
+    else
+    {
+        std::vector<Long> wgts;
+        wgts.reserve(boxes.size());
+        for (int i = 0, N = static_cast<int>(boxes.size()); i < N; ++i) {
+            wgts.push_back(boxes[i].numPts());
+        }
+
+        GraphProcessorMapDoIt(boxes,wgts,nprocs);
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray&          boxes,
+                                        const std::vector<Long>& wgts,
+                                        int                      nprocs,
+                                        Real*                    eff)
+{
+    BL_ASSERT( ! boxes.empty());
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(wgts.size());
+
+    if (boxes.size() <= nprocs || boxes.size() < sfc_threshold*nprocs)
+    {
+        KnapSackProcessorMap(wgts,nprocs,eff);
+    }
+    else
+    {
+        GraphProcessorMapDoIt(boxes,wgts,nprocs,eff);
+    }
+
+    if (topology_aware) {
+        TopologyRemap(boxes);
+    }
 }
 
 void
@@ -1739,6 +2809,33 @@ DistributionMapping::makeKnapSack (const MultiFab& weight, Real& eff, int nmax)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeIncremental (const DistributionMapping& olddm,
+                                      const Vector<Real>& rcost,
+                                      const Vector<Long>& bytes,
+                                      Real target_efficiency,
+                                      Real& old_efficiency, Real& new_efficiency,
+                                      Long& moved_bytes)
+{
+    BL_PROFILE("makeIncremental");
+
+    DistributionMapping r;
+
+    Vector<Long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9_rt : 1.e9_rt/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = Long(rcost[i]*scale) + 1L;
+    }
+
+    r.IncrementalProcessorMap(olddm, cost, bytes, target_efficiency,
+                              old_efficiency, new_efficiency, moved_bytes);
+
+    return r;
+}
+
 DistributionMapping
 DistributionMapping::makeRoundRobin (const MultiFab& weight)
 {
@@ -1818,6 +2915,29 @@ DistributionMapping::makeSFC (const Vector<Real>& rcost, const BoxArray& ba, Rea
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeGraph (const Vector<Real>& rcost, const BoxArray& ba, Real& eff)
+{
+    BL_PROFILE("makeGraph");
+
+    DistributionMapping r;
+
+    std::vector<Long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9_rt : 1.e9_rt/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = Long(rcost[i]*scale) + 1L;
+    }
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.GraphProcessorMap(ba, cost, nprocs, &eff);
+
+    return r;
+}
+
 DistributionMapping
 DistributionMapping::makeSFC (const LayoutData<Real>& rcost_local,
                               Real& currentEfficiency, Real& proposedEfficiency,
@@ -1889,22 +3009,21 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, const int np
 {
     BL_PROFILE("makeSFC");
 
+    const bool hilbert = (m_Strategy == HILBERT);
+
     const int N = static_cast<int>(ba.size());
-    std::vector<SFCToken> tokens;
+    std::vector<SFCToken> tokens = makeSFCTokens(ba, hilbert);
     std::vector<Long> wgts;
-    tokens.reserve(N);
     wgts.reserve(N);
     Long vol_sum = 0;
     for (int i = 0; i < N; ++i)
     {
-        const Box& bx = ba[i];
-        tokens.push_back(makeSFCToken(i, bx.smallEnd()));
-        const Long v = use_box_vol ? bx.numPts() : Long(1);
+        const Long v = use_box_vol ? ba[i].numPts() : Long(1);
         vol_sum += v;
         wgts.push_back(v);
     }
     //
-    // Put'm in Morton space filling curve order.
+    // Put'm in Morton or Hilbert space filling curve order.
     //
     std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
 
@@ -1912,7 +3031,11 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, const int np
 
     std::vector< std::vector<int> > r(nprocs);
 
-    Distribute(tokens, wgts, nprocs, volper, r);
+    if (hilbert) {
+        DistributeChains(tokens, wgts, nprocs, r);
+    } else {
+        Distribute(tokens, wgts, nprocs, volper, r);
+    }
 
     return r;
 }
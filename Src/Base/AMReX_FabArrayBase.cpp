@@ -1,10 +1,13 @@
 
 #include <AMReX_FabArrayBase.H>
+#include <AMReX_CommProgress.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_NonLocalBC.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParallelReduce.H>
 
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
@@ -23,6 +26,13 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <sstream>
 #include <utility>
 
 namespace amrex {
@@ -31,6 +41,18 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::persistent_comm;
+bool    FabArrayBase::neighbor_collectives;
+Long    FabArrayBase::comm_cache_max_bytes;
+int     FabArrayBase::comm_cache_min_entries;
+Long    FabArrayBase::m_comm_cache_clock = 0;
+MsgCompression::Codec FabArrayBase::comm_compression = MsgCompression::Codec::none;
+Real    FabArrayBase::comm_compression_tol;
+Long    FabArrayBase::comm_compression_min_bytes;
+bool    FabArrayBase::comm_compression_intranode;
+bool    FabArrayBase::stagger_sends;
+bool    FabArrayBase::comm_buffer_pool;
+int     FabArrayBase::mem_timeline;
 
 #if defined(AMREX_USE_GPU)
 
@@ -90,6 +112,71 @@ namespace
 {
     Arena* the_fa_arena = nullptr;
     bool initialized = false;
+
+    struct MemEvent
+    {
+        double time;
+        std::string label;  //!< tags of the FabArray
+        Long nbytes;        //!< allocated (> 0) or freed (< 0)
+        Long total;         //!< of all FabArrays afterwards
+    };
+
+    struct MemPeak
+    {
+        Long nbytes = 0;
+        double time = 0.;
+        std::map<std::string,Long> resident;
+        std::vector<MemEvent> timeline;
+    };
+
+    std::deque<MemEvent> mem_events;
+    MemPeak mem_peak;
+
+    // Per-thread space to compress and decompress messages in, kept across
+    // calls.
+    Vector<Vector<char>> codec_scratch;
+
+    char* codecScratch (std::size_t nbytes)
+    {
+        auto& buf = codec_scratch[OpenMP::get_thread_num()];
+        if (buf.size() < nbytes) { buf.resize(nbytes); }
+        return buf.data();
+    }
+
+    // FabArrays sharing metadata may be communicated from different threads.
+    std::mutex copyplan_mutex;
+
+    // Offsets above ParallelDescriptor::MaxTag() of the tags held by
+    // persistent requests.
+    std::set<int> persistent_tags;
+
+    //
+    // Persistent requests and graph communicators kept with the cache
+    // entries pair up across ranks, so with them all ranks have to evict
+    // the same entries.
+    //
+    bool evictCollectively ()
+    {
+        return (FabArrayBase::persistent_comm || FabArrayBase::neighbor_collectives) &&
+            ParallelContext::NProcsSub() > 1;
+    }
+
+    //
+    // Whether to evict the least recently used entry, last used at
+    // last_use (-1 if there is none), of a cache holding bytes.  The caches
+    // are used collectively and hence have the same entries and ages on all
+    // ranks; collectively, they evict if any rank is over budget and they
+    // all picked the same entry.
+    //
+    bool evictLRU (Long bytes, Long last_use)
+    {
+        if (!evictCollectively()) {
+            return bytes > FabArrayBase::comm_cache_max_bytes && last_use >= 0;
+        }
+        Long v[3] = {bytes, last_use, -last_use};
+        ParallelAllReduce::Max(v, 3, ParallelContext::CommunicatorSub());
+        return v[0] > FabArrayBase::comm_cache_max_bytes && v[1] >= 0 && v[1] == -v[2];
+    }
 }
 
 void
@@ -102,6 +189,17 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::MaxComp           = 25;
+    FabArrayBase::persistent_comm   = false;
+    FabArrayBase::neighbor_collectives = false;
+    FabArrayBase::comm_cache_max_bytes = -1;
+    FabArrayBase::comm_cache_min_entries = 16;
+    FabArrayBase::comm_compression = MsgCompression::Codec::none;
+    FabArrayBase::comm_compression_tol = 0;
+    FabArrayBase::comm_compression_min_bytes = 65536;
+    FabArrayBase::comm_compression_intranode = false;
+    FabArrayBase::stagger_sends     = false;
+    FabArrayBase::comm_buffer_pool  = false;
+    FabArrayBase::mem_timeline      = 0;
 
     ParmParse pp("fabarray");
 
@@ -118,11 +216,32 @@ FabArrayBase::Initialize ()
     }
 
     pp.queryAdd("maxcomp",             FabArrayBase::MaxComp);
+    pp.queryAdd("persistent_comm",     FabArrayBase::persistent_comm);
+    pp.queryAdd("neighbor_collectives", FabArrayBase::neighbor_collectives);
+    pp.queryAdd("comm_cache_max_bytes", FabArrayBase::comm_cache_max_bytes);
+    pp.queryAdd("comm_cache_min_entries", FabArrayBase::comm_cache_min_entries);
+    {
+        std::string codec("none");
+        pp.queryAdd("comm_compression", codec);
+        FabArrayBase::comm_compression = MsgCompression::toCodec(codec);
+    }
+    pp.queryAdd("comm_compression_tol", FabArrayBase::comm_compression_tol);
+    pp.queryAdd("comm_compression_min_bytes", FabArrayBase::comm_compression_min_bytes);
+    pp.queryAdd("comm_compression_intranode", FabArrayBase::comm_compression_intranode);
+    pp.queryAdd("stagger_sends",       FabArrayBase::stagger_sends);
+    pp.queryAdd("comm_buffer_pool",    FabArrayBase::comm_buffer_pool);
+    pp.queryAdd("mem_timeline",        FabArrayBase::mem_timeline);
+
+    CommProgress::Initialize();
 
     if (MaxComp < 1) {
         MaxComp = 1;
     }
 
+    // getFB and getCPC may be called for a few FabArrays before the first
+    // of the returned references is used.
+    comm_cache_min_entries = std::max(comm_cache_min_entries, 4);
+
 #ifdef AMREX_USE_GPU
     if (ParallelDescriptor::UseGpuAwareMpi()) {
         the_fa_arena = The_Arena();
@@ -271,9 +390,46 @@ FabArrayBase::FB::bytes () const
     if (m_RcvTags)
         cnt += FabArrayBase::bytesOfMapOfCopyComTagContainers(*m_RcvTags);
 
+    if (m_offnode) {
+        cnt += FabArrayBase::bytesOfMapOfCopyComTagContainers(*m_offnode->m_SndTags)
+            +  FabArrayBase::bytesOfMapOfCopyComTagContainers(*m_offnode->m_RcvTags)
+            +  FabArrayBase::bytesOfMapOfCopyComTagContainers(*m_NodeRcvTags);
+    }
+
     return cnt;
 }
 
+void
+FabArrayBase::FB::splitNodeTags () const
+{
+    if (m_offnode) { return; }
+
+    // Ranks on this node read our data directly, so the sends to them are
+    // dropped, and the receives from them become copies.
+    auto offnode = std::make_unique<CommMetaData>();
+    offnode->m_threadsafe_loc = m_threadsafe_loc;
+    offnode->m_threadsafe_rcv = m_threadsafe_rcv;
+    offnode->m_LocTags = std::make_unique<CopyComTagsContainer>();
+    offnode->m_SndTags = std::make_unique<MapOfCopyComTagContainers>();
+    offnode->m_RcvTags = std::make_unique<MapOfCopyComTagContainers>();
+    m_NodeRcvTags = std::make_unique<MapOfCopyComTagContainers>();
+
+    for (auto const& kv : *m_SndTags) {
+        if (ParallelDescriptor::NodeRank(kv.first) < 0) {
+            offnode->m_SndTags->insert(kv);
+        }
+    }
+    for (auto const& kv : *m_RcvTags) {
+        if (ParallelDescriptor::NodeRank(kv.first) < 0) {
+            offnode->m_RcvTags->insert(kv);
+        } else {
+            m_NodeRcvTags->insert(kv);
+        }
+    }
+
+    m_offnode = std::move(offnode);
+}
+
 Long
 FabArrayBase::TileArray::bytes () const
 {
@@ -283,7 +439,280 @@ FabArrayBase::TileArray::bytes () const
         + (amrex::bytesOf(this->indexMap)          - sizeof(this->indexMap))
         + (amrex::bytesOf(this->localIndexMap)     - sizeof(this->localIndexMap))
         + (amrex::bytesOf(this->localTileIndexMap) - sizeof(this->localTileIndexMap))
-        + (amrex::bytesOf(this->tileArray)         - sizeof(this->tileArray));
+        + (amrex::bytesOf(this->tileArray)         - sizeof(this->tileArray))
+        + std::accumulate(regionTiles.begin(), regionTiles.end(), Long(0),
+                          [] (Long r, auto const& kv) { return r + kv.second->bytes(); });
+}
+
+FabArrayBase::PersistentComm::~PersistentComm ()
+{
+#ifdef BL_USE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        for (auto& req : recv_reqs) {
+            if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+        }
+        for (auto& req : send_reqs) {
+            if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+        }
+    }
+#endif
+    if (the_recv_data) { The_FA_Arena()->free(the_recv_data); }
+    if (the_send_data) { The_FA_Arena()->free(the_send_data); }
+    if (tag >= 0) { persistent_tags.erase(tag - ParallelDescriptor::MaxTag()); }
+}
+
+int
+FabArrayBase::PersistentComm::reserveTag ()
+{
+    // All ranks reserve and release tags in the same order, so they pick
+    // the same one.
+    for (int i = 1; i <= ParallelDescriptor::NumReservedTags; ++i) {
+        if (persistent_tags.insert(i).second) {
+            return ParallelDescriptor::MaxTag() + i;
+        }
+    }
+    return -1;
+}
+
+void
+FabArrayBase::PersistentComm::startRecvs ()
+{
+#ifdef BL_USE_MPI
+    for (auto& req : recv_reqs) {
+        if (req != MPI_REQUEST_NULL) { BL_MPI_REQUIRE( MPI_Start(&req) ); }
+    }
+#endif
+}
+
+void
+FabArrayBase::PersistentComm::startSends ()
+{
+#ifdef BL_USE_MPI
+    for (auto& req : send_reqs) {
+        if (req != MPI_REQUEST_NULL) { BL_MPI_REQUIRE( MPI_Start(&req) ); }
+    }
+#endif
+}
+
+FabArrayBase::CommBuffers::~CommBuffers ()
+{
+    if (the_recv_data) { The_FA_Arena()->free(the_recv_data); }
+    if (the_send_data) { The_FA_Arena()->free(the_send_data); }
+}
+
+char*
+FabArrayBase::CommBuffers::sendBuffer (std::size_t nbytes)
+{
+    if (nbytes > send_bytes) {
+        if (the_send_data) { The_FA_Arena()->free(the_send_data); }
+        the_send_data = static_cast<char*>(The_FA_Arena()->alloc(nbytes));
+        if (owner) { owner->addCacheBytes(static_cast<Long>(nbytes - send_bytes)); }
+        send_bytes = nbytes;
+    }
+    return the_send_data;
+}
+
+char*
+FabArrayBase::CommBuffers::recvBuffer (std::size_t nbytes)
+{
+    if (nbytes > recv_bytes) {
+        if (the_recv_data) { The_FA_Arena()->free(the_recv_data); }
+        the_recv_data = static_cast<char*>(The_FA_Arena()->alloc(nbytes));
+        if (owner) { owner->addCacheBytes(static_cast<Long>(nbytes - recv_bytes)); }
+        recv_bytes = nbytes;
+    }
+    return the_recv_data;
+}
+
+void
+FabArrayBase::CommMetaData::addCacheBytes (Long nbytes) const noexcept
+{
+    m_cache_bytes += nbytes;
+    if (m_cache_stats) {
+        m_cache_stats->bytes += nbytes;
+        m_cache_stats->bytes_hwm = std::max(m_cache_stats->bytes_hwm, m_cache_stats->bytes);
+    }
+}
+
+const FabArrayBase::CopyPlan&
+FabArrayBase::getCopyPlan (const CommMetaData& cmd) const
+{
+    std::lock_guard<std::mutex> lock(copyplan_mutex);
+
+    for (auto const& p : cmd.m_copyplans) {
+        if (p->ngrow == n_grow) { return *p; }
+    }
+
+    BL_PROFILE("FabArrayBase::getCopyPlan()");
+
+    auto plan = std::make_unique<CopyPlan>();
+    plan->ngrow = n_grow;
+    auto& runs = plan->runs;
+
+    // Rows of bx that continue the previous one both in the fab and in the
+    // message, e.g., when bx spans the fab in x, are merged.
+    auto make_seg = [&] (int msg, int fab, Box const& bx, Long base)
+    {
+        const Box& fb = fabbox(fab);
+        const auto lo = amrex::lbound(bx);
+        const auto len = amrex::length(bx);
+        const auto flo = amrex::lbound(fb);
+        const auto flen = amrex::length(fb);
+
+        CopyPlan::Seg seg{msg, fab, fb.numPts(), bx.numPts(), base,
+                          static_cast<int>(runs.size()), 0};
+        for (int k = 0; k < len.z; ++k) {
+            for (int j = 0; j < len.y; ++j) {
+                const Long fab_off = (lo.x-flo.x) + Long(lo.y+j-flo.y)*flen.x
+                    + Long(lo.z+k-flo.z)*flen.x*flen.y;
+                const Long buf_off = j*Long(len.x) + k*Long(len.x)*len.y;
+                if (static_cast<int>(runs.size()) > seg.run_begin &&
+                    runs.back().fab_off + runs.back().len == fab_off &&
+                    runs.back().buf_off + runs.back().len == buf_off) {
+                    runs.back().len += len.x;
+                } else {
+                    runs.push_back({fab_off, buf_off, Long(len.x)});
+                }
+            }
+        }
+        seg.run_end = static_cast<int>(runs.size());
+        return seg;
+    };
+
+    int msg = 0;
+    for (auto const& kv : *cmd.m_SndTags) {
+        plan->snd_msg.push_back(static_cast<int>(plan->snd_segs.size()));
+        Long base = 0;
+        for (auto const& tag : kv.second) {
+            plan->snd_segs.push_back(make_seg(msg, tag.srcIndex, tag.sbox, base));
+            base += tag.sbox.numPts();
+        }
+        ++msg;
+    }
+    plan->snd_msg.push_back(static_cast<int>(plan->snd_segs.size()));
+
+    msg = 0;
+    for (auto const& kv : *cmd.m_RcvTags) {
+        Long base = 0;
+        for (auto const& tag : kv.second) {
+            plan->rcv_segs.push_back(make_seg(msg, tag.dstIndex, tag.dbox, base));
+            base += tag.dbox.numPts();
+        }
+        ++msg;
+    }
+
+    // The segments of a fab are unpacked by one thread.
+    auto& segs = plan->rcv_segs;
+    std::stable_sort(segs.begin(), segs.end(),
+                     [] (CopyPlan::Seg const& a, CopyPlan::Seg const& b) { return a.fab < b.fab; });
+    for (int i = 0, N = static_cast<int>(segs.size()); i < N; ++i) {
+        if (i == 0 || segs[i].fab != segs[i-1].fab) {
+            plan->rcv_fab.push_back(i);
+        }
+    }
+    plan->rcv_fab.push_back(static_cast<int>(segs.size()));
+
+    cmd.addCacheBytes(sizeof(CopyPlan)
+                      + (amrex::bytesOf(plan->snd_segs) - sizeof(plan->snd_segs))
+                      + (amrex::bytesOf(plan->snd_msg)  - sizeof(plan->snd_msg))
+                      + (amrex::bytesOf(plan->rcv_segs) - sizeof(plan->rcv_segs))
+                      + (amrex::bytesOf(plan->rcv_fab)  - sizeof(plan->rcv_fab))
+                      + (amrex::bytesOf(plan->runs)     - sizeof(plan->runs)));
+    cmd.m_copyplans.push_back(std::move(plan));
+    return *cmd.m_copyplans.back();
+}
+
+FabArrayBase::NeighborComm::~NeighborComm ()
+{
+#ifdef BL_USE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized && comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&comm);
+    }
+#endif
+}
+
+MPI_Comm
+FabArrayBase::CommMetaData::neighborComm () const
+{
+#ifdef BL_USE_MPI
+    MPI_Comm parent = ParallelContext::CommunicatorSub();
+    if (m_neighbor && m_neighbor->parent == parent) {
+        return m_neighbor->comm;
+    }
+
+    BL_PROFILE("CommMetaData::neighborComm()");
+
+    Vector<int> sources, destinations;
+    for (auto const& kv : *m_RcvTags) {
+        sources.push_back(ParallelContext::global_to_local_rank(kv.first));
+    }
+    for (auto const& kv : *m_SndTags) {
+        destinations.push_back(ParallelContext::global_to_local_rank(kv.first));
+    }
+
+    m_neighbor = std::make_unique<NeighborComm>();
+    m_neighbor->parent = parent;
+    BL_MPI_REQUIRE( MPI_Dist_graph_create_adjacent(parent,
+                        static_cast<int>(sources.size()), sources.data(), MPI_UNWEIGHTED,
+                        static_cast<int>(destinations.size()), destinations.data(), MPI_UNWEIGHTED,
+                        MPI_INFO_NULL, 0, &m_neighbor->comm) );
+    return m_neighbor->comm;
+#else
+    return MPI_COMM_NULL;
+#endif
+}
+
+void
+FabArrayBase::NeighborExchange::start (MPI_Comm graph_comm,
+                                       char* the_send_data, Vector<char*> const& send_data,
+                                       Vector<std::size_t> const& send_size,
+                                       char* the_recv_data, Vector<char*> const& recv_data,
+                                       Vector<std::size_t> const& recv_size)
+{
+#ifdef BL_USE_MPI
+    auto to_int = [] (std::size_t n) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(n <= static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                                         "fabarray.neighbor_collectives: message too large");
+        return static_cast<int>(n);
+    };
+
+    const auto nsend = send_size.size();
+    send_counts.resize(nsend);
+    send_displs.resize(nsend);
+    for (Long i = 0; i < nsend; ++i) {
+        send_counts[i] = to_int(send_size[i]);
+        send_displs[i] = send_data[i] ? to_int(send_data[i] - the_send_data) : 0;
+    }
+
+    const auto nrecv = recv_size.size();
+    recv_counts.resize(nrecv);
+    recv_displs.resize(nrecv);
+    for (Long i = 0; i < nrecv; ++i) {
+        recv_counts[i] = to_int(recv_size[i]);
+        recv_displs[i] = recv_data[i] ? to_int(recv_data[i] - the_recv_data) : 0;
+    }
+
+    BL_MPI_REQUIRE( MPI_Ineighbor_alltoallv(the_send_data, send_counts.data(), send_displs.data(), MPI_CHAR,
+                                            the_recv_data, recv_counts.data(), recv_displs.data(), MPI_CHAR,
+                                            graph_comm, &req) );
+#else
+    amrex::ignore_unused(graph_comm, the_send_data, send_data, send_size,
+                         the_recv_data, recv_data, recv_size);
+#endif
+}
+
+void
+FabArrayBase::NeighborExchange::wait ()
+{
+#ifdef BL_USE_MPI
+    if (req != MPI_REQUEST_NULL) {
+        BL_MPI_REQUIRE( MPI_Wait(&req, MPI_STATUS_IGNORE) );
+    }
+#endif
 }
 
 //
@@ -537,9 +966,7 @@ FabArrayBase::flushCPC (bool no_assertion) const
             }
         }
 
-#ifdef AMREX_MEM_PROFILING
-        m_CPC_stats.bytes -= it->second->bytes();
-#endif
+        m_CPC_stats.bytes -= it->second->m_cache_bytes;
         m_CPC_stats.recordErase(it->second->m_nuse);
         delete it->second;
     }
@@ -566,9 +993,7 @@ FabArrayBase::flushCPCache ()
         delete c;
     }
     m_TheCPCache.clear();
-#ifdef AMREX_MEM_PROFILING
     m_CPC_stats.bytes = 0L;
-#endif
 }
 
 const FabArrayBase::CPC&
@@ -598,6 +1023,7 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
             it->second->m_dstba  == boxArray())
         {
             ++(it->second->m_nuse);
+            it->second->m_last_use = ++m_comm_cache_clock;
             m_CPC_stats.recordUse();
             return *(it->second);
         }
@@ -606,12 +1032,13 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
     // Have to build a new one
     CPC* new_cpc = new CPC(*this, dstng, src, srcng, period, to_ghost_cells_only);
 
-#ifdef AMREX_MEM_PROFILING
-    m_CPC_stats.bytes += new_cpc->bytes();
+    new_cpc->m_cache_bytes = new_cpc->bytes();
+    new_cpc->m_cache_stats = &m_CPC_stats;
+    m_CPC_stats.bytes += new_cpc->m_cache_bytes;
     m_CPC_stats.bytes_hwm = std::max(m_CPC_stats.bytes_hwm, m_CPC_stats.bytes);
-#endif
 
     new_cpc->m_nuse = 1;
+    new_cpc->m_last_use = ++m_comm_cache_clock;
     m_CPC_stats.recordBuild();
     m_CPC_stats.recordUse();
 
@@ -620,9 +1047,59 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
         m_TheCPCache.insert(          CPCache::value_type(srckey,new_cpc));
     }
 
+    trimCPCache(new_cpc);
+
     return *new_cpc;
 }
 
+void
+FabArrayBase::trimCPCache (const CPC* keep)
+{
+    if (comm_cache_max_bytes < 0) { return; }
+
+    while (evictCollectively() || m_CPC_stats.bytes > comm_cache_max_bytes)
+    {
+        // Each CPC is in the cache once under its source key.
+        std::vector<CPC*> cpcs;
+        for (auto const& it : m_TheCPCache) {
+            if (it.first == it.second->m_srcbdk) {
+                cpcs.push_back(it.second);
+            }
+        }
+
+        CPC* victim = nullptr;
+        if (static_cast<int>(cpcs.size()) > comm_cache_min_entries)
+        {
+            std::sort(cpcs.begin(), cpcs.end(),
+                      [] (CPC const* a, CPC const* b) { return a->m_last_use > b->m_last_use; });
+
+            for (auto i = cpcs.size(); i > static_cast<std::size_t>(comm_cache_min_entries); --i) {
+                CPC* c = cpcs[i-1];
+                if (c != keep && c->m_inflight == 0) {
+                    victim = c;
+                    break;
+                }
+            }
+        }
+        if (!evictLRU(m_CPC_stats.bytes, victim ? victim->m_last_use : -1)) { return; }
+
+        for (auto const& key : {victim->m_srcbdk, victim->m_dstbdk}) {
+            auto er_it = m_TheCPCache.equal_range(key);
+            for (auto it = er_it.first; it != er_it.second; ) {
+                if (it->second == victim) {
+                    it = m_TheCPCache.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        m_CPC_stats.bytes -= victim->m_cache_bytes;
+        m_CPC_stats.recordEvict(victim->m_nuse);
+        delete victim;
+    }
+}
+
 //
 // Some stuff for fill boundary
 //
@@ -1179,9 +1656,7 @@ FabArrayBase::flushFB (bool no_assertion) const
     std::pair<FBCacheIter,FBCacheIter> er_it = m_TheFBCache.equal_range(m_bdkey);
     for (auto it = er_it.first; it != er_it.second; ++it)
     {
-#ifdef AMREX_MEM_PROFILING
-        m_FBC_stats.bytes -= it->second->bytes();
-#endif
+        m_FBC_stats.bytes -= it->second->m_cache_bytes;
         m_FBC_stats.recordErase(it->second->m_nuse);
         delete it->second;
     }
@@ -1197,9 +1672,7 @@ FabArrayBase::flushFBCache ()
         delete it.second;
     }
     m_TheFBCache.clear();
-#ifdef AMREX_MEM_PROFILING
     m_FBC_stats.bytes = 0L;
-#endif
 }
 
 const FabArrayBase::FB&
@@ -1223,6 +1696,7 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
             it->second->m_period     == period              )
         {
             ++(it->second->m_nuse);
+            it->second->m_last_use = ++m_comm_cache_clock;
             m_FBC_stats.recordUse();
             return *(it->second);
         }
@@ -1232,20 +1706,189 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
     FB* new_fb = new FB(*this, nghost, cross, period, enforce_periodicity_only,
                         override_sync, m_multi_ghost);
 
-#ifdef AMREX_MEM_PROFILING
-    m_FBC_stats.bytes += new_fb->bytes();
+    new_fb->m_cache_bytes = new_fb->bytes();
+    new_fb->m_cache_stats = &m_FBC_stats;
+    m_FBC_stats.bytes += new_fb->m_cache_bytes;
     m_FBC_stats.bytes_hwm = std::max(m_FBC_stats.bytes_hwm, m_FBC_stats.bytes);
-#endif
 
     new_fb->m_nuse = 1;
+    new_fb->m_last_use = ++m_comm_cache_clock;
     m_FBC_stats.recordBuild();
     m_FBC_stats.recordUse();
 
     m_TheFBCache.insert(er_it.second, FBCache::value_type(m_bdkey,new_fb));
 
+    trimFBCache(new_fb);
+
     return *new_fb;
 }
 
+void
+FabArrayBase::trimFBCache (const FB* keep)
+{
+    if (comm_cache_max_bytes < 0) { return; }
+
+    while (evictCollectively() || m_FBC_stats.bytes > comm_cache_max_bytes)
+    {
+        auto victim = m_TheFBCache.end();
+        if (static_cast<int>(m_TheFBCache.size()) > comm_cache_min_entries)
+        {
+            std::vector<FBCacheIter> its;
+            its.reserve(m_TheFBCache.size());
+            for (auto it = m_TheFBCache.begin(); it != m_TheFBCache.end(); ++it) {
+                its.push_back(it);
+            }
+            std::sort(its.begin(), its.end(), [] (FBCacheIter const& a, FBCacheIter const& b)
+                      { return a->second->m_last_use > b->second->m_last_use; });
+
+            for (auto i = its.size(); i > static_cast<std::size_t>(comm_cache_min_entries); --i) {
+                FB const* fb = its[i-1]->second;
+                if (fb != keep && fb->m_inflight == 0) {
+                    victim = its[i-1];
+                    break;
+                }
+            }
+        }
+        if (!evictLRU(m_FBC_stats.bytes,
+                      (victim != m_TheFBCache.end()) ? victim->second->m_last_use : -1)) {
+            return;
+        }
+
+        m_FBC_stats.bytes -= victim->second->m_cache_bytes;
+        m_FBC_stats.recordEvict(victim->second->m_nuse);
+        delete victim->second;
+        m_TheFBCache.erase(victim);
+    }
+}
+
+void
+FabArrayBase::compressSendBuffers (Vector<char*> const& send_data, Vector<std::size_t>& send_size,
+                                   Vector<int> const& send_rank,
+                                   Vector<const CopyComTagsContainer*> const& send_cctc,
+                                   int ncomp, int elem_size) const
+{
+#ifdef BL_USE_MPI
+    if (m_comm_codec == MsgCompression::Codec::none) { return; }
+
+    BL_PROFILE("FabArrayBase::compressSendBuffers()");
+
+    const auto N_snds = static_cast<int>(send_data.size());
+    codec_scratch.resize(OpenMP::get_max_threads());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int j = 0; j < N_snds; ++j)
+    {
+        // Messages within a node are usually not bandwidth bound.  Messages
+        // too large for MPI_CHAR are received with a different type.
+        if (send_size[j] < static_cast<std::size_t>(comm_compression_min_bytes) ||
+            (!comm_compression_intranode && ParallelDescriptor::NodeRank(send_rank[j]) >= 0) ||
+            ParallelDescriptor::select_comm_data_type(send_size[j]) != 1) {
+            continue;
+        }
+
+        std::size_t nbytes = 0;
+        for (auto const& tag : *send_cctc[j]) {
+            nbytes += tag.sbox.numPts() * ncomp * elem_size;
+        }
+
+        // A message is known to be compressed because it is shorter than
+        // the receive buffer.
+        char* buf = codecScratch(send_size[j]-1);
+        auto r = MsgCompression::compress(m_comm_codec, m_comm_codec_tol, elem_size,
+                                          send_data[j], nbytes, buf, send_size[j]-1);
+        if (r > 0) {
+            std::memcpy(send_data[j], buf, r);
+            send_size[j] = r;
+        }
+    }
+#else
+    amrex::ignore_unused(send_data, send_size, send_rank, send_cctc, ncomp, elem_size);
+#endif
+}
+
+void
+FabArrayBase::decompressRecvBuffers (Vector<char*> const& recv_data,
+                                     Vector<std::size_t> const& recv_size,
+                                     Vector<std::size_t> const& recv_count,
+                                     Vector<const CopyComTagsContainer*> const& recv_cctc,
+                                     int ncomp, int elem_size)
+{
+    BL_PROFILE("FabArrayBase::decompressRecvBuffers()");
+
+    const auto N_rcvs = static_cast<int>(recv_data.size());
+    codec_scratch.resize(OpenMP::get_max_threads());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int k = 0; k < N_rcvs; ++k)
+    {
+        if (recv_size[k] > 0 && recv_count[k] < recv_size[k])
+        {
+            std::size_t nbytes = 0;
+            for (auto const& tag : *recv_cctc[k]) {
+                nbytes += tag.dbox.numPts() * ncomp * elem_size;
+            }
+            char* buf = codecScratch(recv_count[k]);
+            std::memcpy(buf, recv_data[k], recv_count[k]);
+            MsgCompression::decompress(elem_size, buf, recv_count[k], recv_data[k], nbytes);
+        }
+    }
+}
+
+void
+FabArrayBase::dumpCommCaches (std::ostream& os)
+{
+    auto print_stats = [&] (CacheStats const& stats, std::size_t n)
+    {
+        os << "### " << stats.name << " on rank " << ParallelDescriptor::MyProc()
+           << ": " << n << " entries, " << stats.bytes << " bytes (hwm " << stats.bytes_hwm
+           << ", budget " << comm_cache_max_bytes << "), " << stats.nuse - stats.nbuild
+           << " hits, " << stats.nbuild << " misses, " << stats.nevict << " evictions\n";
+    };
+
+    auto periodic = [] (Periodicity const& period)
+    {
+        IntVect r(0);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            r[idim] = period.isPeriodic(idim);
+        }
+        return r;
+    };
+
+    auto print_entry = [&] (CommMetaData const& cmd, Long nuse)
+    {
+        os << " uses " << nuse << " bytes " << cmd.m_cache_bytes
+           << " age " << m_comm_cache_clock - cmd.m_last_use
+           << " inflight " << cmd.m_inflight
+           << " nsend " << (cmd.m_SndTags ? cmd.m_SndTags->size() : 0)
+           << " nrecv " << (cmd.m_RcvTags ? cmd.m_RcvTags->size() : 0) << "\n";
+    };
+
+    print_stats(m_FBC_stats, m_TheFBCache.size());
+    for (auto const& it : m_TheFBCache) {
+        FB const& fb = *it.second;
+        os << "  FB " << it.first << " ngrow " << fb.m_ngrow
+           << " periodic " << periodic(fb.m_period);
+        print_entry(fb, fb.m_nuse);
+    }
+
+    std::size_t ncpc = 0;
+    for (auto const& it : m_TheCPCache) {
+        if (it.first == it.second->m_srcbdk) { ++ncpc; }
+    }
+    print_stats(m_CPC_stats, ncpc);
+    for (auto const& it : m_TheCPCache) {
+        if (it.first == it.second->m_srcbdk) {
+            CPC const& cpc = *it.second;
+            os << "  CPC " << cpc.m_srcbdk << " -> " << cpc.m_dstbdk
+               << " srcng " << cpc.m_srcng << " dstng " << cpc.m_dstng
+               << " periodic " << periodic(cpc.m_period);
+            print_entry(cpc, cpc.m_nuse);
+        }
+    }
+}
+
 FabArrayBase::RB90::RB90 (const FabArrayBase& fa, const IntVect& nghost, Box const& domain)
     : m_ngrow(nghost), m_domain(domain)
 {
@@ -2186,6 +2829,8 @@ FabArrayBase::flushCFinfo (bool no_assertion) const
 void
 FabArrayBase::Finalize ()
 {
+    CommProgress::Finalize();
+
     FabArrayBase::flushFBCache();
     FabArrayBase::flushCPCache();
     FabArrayBase::flushRB90Cache();
@@ -2197,6 +2842,8 @@ FabArrayBase::Finalize ()
     FabArrayBase::flushParForCache();
 #endif
 
+    codec_scratch.clear();
+
     if (ParallelDescriptor::IOProcessor() && amrex::system::verbose > 1) {
         m_FA_stats.print();
         m_TAC_stats.print();
@@ -2209,7 +2856,12 @@ FabArrayBase::Finalize ()
     if (amrex::system::verbose > 1) {
         printMemUsage();
     }
+    if (mem_timeline > 0) {
+        printMemPeak();
+    }
     m_region_tag.clear();
+    mem_events.clear();
+    mem_peak = MemPeak();
 
     m_TAC_stats = CacheStats("TileArrayCache");
     m_FBC_stats = CacheStats("FBCache");
@@ -2261,6 +2913,81 @@ FabArrayBase::getTileArray (const IntVect& tilesize) const
     return p;
 }
 
+const FabArrayBase::TileArray*
+FabArrayBase::getTileArray (const IntVect& tilesize, TileRegion region,
+                            const IntVect& ngrow) const
+{
+    const TileArray* pta = getTileArray(tilesize);
+    if (region == TileRegion::all) { return pta; }
+
+    TileArray* p;
+
+#ifdef AMREX_USE_OMP
+#pragma omp critical(gettilearray)
+#endif
+    {
+        auto& rta = const_cast<TileArray*>(pta)->regionTiles[std::make_pair(region,ngrow)];
+        if (!rta) {
+            rta = std::make_unique<TileArray>();
+            buildRegionTileArray(*pta, region, ngrow, *rta);
+            rta->nuse = 0;
+#ifdef AMREX_MEM_PROFILING
+            m_TAC_stats.bytes += rta->bytes();
+            m_TAC_stats.bytes_hwm = std::max(m_TAC_stats.bytes_hwm,
+                                             m_TAC_stats.bytes);
+#endif
+        }
+        p = rta.get();
+#ifdef AMREX_USE_OMP
+#pragma omp master
+#endif
+        {
+            ++(p->nuse);
+        }
+    }
+
+    return p;
+}
+
+void
+FabArrayBase::buildRegionTileArray (const TileArray& ta, TileRegion region,
+                                    const IntVect& ngrow, TileArray& rta) const
+{
+    // The tiles of a box are contiguous in ta.  The interior and the shell
+    // are both cell-centered like the tiles, so that they partition the
+    // nodes of nodal boxes the same way the tiles do.
+    const auto N = static_cast<int>(ta.tileArray.size());
+    for (int i = 0; i < N; ) {
+        const int K = ta.indexMap[i];
+        const Box interior = amrex::grow(boxarray.getCellCenteredBox(K), -ngrow);
+
+        Vector<Box> boxes;
+        for (; i < N && ta.indexMap[i] == K; ++i) {
+            const Box& tbx = ta.tileArray[i];
+            if (region == TileRegion::interior) {
+                const Box& b = tbx & interior;
+                if (b.ok()) { boxes.push_back(b); }
+            } else if (interior.ok()) {
+                for (auto const& b : amrex::boxDiff(tbx, interior)) {
+                    boxes.push_back(b);
+                }
+            } else {
+                boxes.push_back(tbx);
+            }
+        }
+
+        const int li = ta.localIndexMap[i-1];
+        const auto ntiles = static_cast<int>(boxes.size());
+        for (int t = 0; t < ntiles; ++t) {
+            rta.indexMap.push_back(K);
+            rta.localIndexMap.push_back(li);
+            rta.localTileIndexMap.push_back(t);
+            rta.numLocalTiles.push_back(ntiles);
+            rta.tileArray.push_back(boxes[t]);
+        }
+    }
+}
+
 void
 FabArrayBase::buildTileArray (const IntVect& tileSize, TileArray& ta) const
 {
@@ -2457,6 +3184,20 @@ FabArrayBase::updateBDKey ()
 
 #ifdef BL_USE_MPI
 
+Vector<std::size_t>
+RecvCounts (Vector<MPI_Status>& recv_stats, const Vector<std::size_t>& recv_size)
+{
+    Vector<std::size_t> r(recv_size);
+    for (int i = 0, n = static_cast<int>(recv_size.size()); i < n; ++i) {
+        if (recv_size[i] > 0 && ParallelDescriptor::select_comm_data_type(recv_size[i]) == 1) {
+            int count = 0;
+            MPI_Get_count(&recv_stats[i], ParallelDescriptor::Mpi_typemap<char>::type(), &count);
+            r[i] = count;
+        }
+    }
+    return r;
+}
+
 bool
 CheckRcvStats (Vector<MPI_Status>& recv_stats, const Vector<std::size_t>& recv_size, int tag)
 {
@@ -2519,6 +3260,79 @@ FabArrayBase::updateMemUsage (std::string const& tag, Long nbytes, Arena const*
     mi.nbytes_hwm = std::max(mi.nbytes, mi.nbytes_hwm);
 }
 
+void
+FabArrayBase::updateMemUsage (Vector<std::string> const& tags, Long nbytes, Arena const* ar)
+{
+    for (auto const& t : tags) {
+        updateMemUsage(t, nbytes, ar);
+    }
+
+    if (mem_timeline > 0 && nbytes != 0) {
+        std::string label;
+        for (auto const& t : tags) {
+            if (t != "All") {
+                label += label.empty() ? t : ", " + t;
+            }
+        }
+        const Long total = m_mem_usage["All"].nbytes;
+        mem_events.push_back(MemEvent{amrex::second(), std::move(label), nbytes, total});
+        while (static_cast<int>(mem_events.size()) > mem_timeline) {
+            mem_events.pop_front();
+        }
+
+        if (total > mem_peak.nbytes) {
+            mem_peak.nbytes = total;
+            mem_peak.time = mem_events.back().time;
+            mem_peak.resident.clear();
+            for (auto const& kv : m_mem_usage) {
+                if (kv.second.nbytes > 0) {
+                    mem_peak.resident[kv.first] = kv.second.nbytes;
+                }
+            }
+            mem_peak.timeline.assign(mem_events.begin(), mem_events.end());
+        }
+    }
+}
+
+void
+FabArrayBase::printMemPeak ()
+{
+    int peak_proc = ParallelDescriptor::MyProc();
+#ifdef BL_USE_MPI
+    {
+        struct { double v; int r; } in{double(mem_peak.nbytes), ParallelDescriptor::MyProc()}, out{};
+        MPI_Allreduce(&in, &out, 1, MPI_DOUBLE_INT, MPI_MAXLOC, ParallelDescriptor::Communicator());
+        peak_proc = out.r;
+    }
+#endif
+    std::ostringstream os;
+    if (ParallelDescriptor::MyProc() == peak_proc)
+    {
+        os << "FabArray memory peaked at " << mem_peak.nbytes << " bytes on process "
+           << peak_proc << " at " << mem_peak.time << " s.  Resident then (tag: bytes):\n";
+        for (auto const& kv : mem_peak.resident) {
+            os << "    " << kv.first << ": " << kv.second << "\n";
+        }
+        if (!mem_peak.timeline.empty()) {
+            os << "  The last allocations and frees (time, bytes, total, tags):\n";
+            for (auto const& e : mem_peak.timeline) {
+                os << "    " << e.time << ", " << e.nbytes << ", " << e.total << ", "
+                   << (e.label.empty() ? std::string("untagged") : e.label) << "\n";
+            }
+        }
+    }
+
+    // The report is made on the peak process and printed by the I/O process.
+    std::string report = os.str();
+#ifdef BL_USE_MPI
+    auto len = static_cast<int>(report.size());
+    ParallelDescriptor::Bcast(&len, 1, peak_proc);
+    report.resize(len);
+    ParallelDescriptor::Bcast(report.data(), len, peak_proc);
+#endif
+    amrex::Print() << report << std::flush;
+}
+
 void
 FabArrayBase::printMemUsage ()
 {
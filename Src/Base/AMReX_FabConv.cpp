@@ -5,10 +5,16 @@
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 namespace amrex {
 
@@ -903,6 +909,225 @@ operator>> (std::istream&   is,
     return is;
 }
 
+//
+// Fast paths for conversions between IEEE 32 and 64 bit reals in native
+// or reversed byte order.  These are the only conversions of any practical
+// importance, e.g., byte-swapped checkpoints or float32 plotfiles.  The
+// vector kernels are selected at compile time from the target ISA, and
+// all other conversions use PD_fconvert.
+//
+
+template <typename U>
+static
+U
+ieee_bswap (U x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (sizeof(U) == 4) {
+        return __builtin_bswap32(x);
+    } else {
+        return __builtin_bswap64(x);
+    }
+#else
+    U r = 0;
+    for (std::size_t b = 0; b < sizeof(U); ++b) {
+        r = (r << 8) | ((x >> (8*b)) & U(0xff));
+    }
+    return r;
+#endif
+}
+
+#if defined(__AVX2__)
+//
+// Shuffle mask reversing the bytes of each NB byte word in 16 bytes.
+//
+template <int NB>
+static
+__m128i
+ieee_bswap_mask ()
+{
+    if constexpr (NB == 4) {
+        return _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    } else {
+        return _mm_setr_epi8(7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8);
+    }
+}
+#endif
+
+template <typename TIn, typename TOut, bool SwapIn, bool SwapOut>
+static
+void
+ieee_convert (char* AMREX_RESTRICT out, const char* AMREX_RESTRICT in, Long nitems)
+{
+    using UIn  = std::conditional_t<sizeof(TIn)  == 4, std::uint32_t, std::uint64_t>;
+    using UOut = std::conditional_t<sizeof(TOut) == 4, std::uint32_t, std::uint64_t>;
+    constexpr int NI = sizeof(TIn);
+    constexpr int NO = sizeof(TOut);
+
+    Long i = 0;
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+    {
+        const __m512i min = _mm512_broadcast_i32x4(ieee_bswap_mask<NI>());
+        const __m512i mout = _mm512_broadcast_i32x4(ieee_bswap_mask<NO>());
+        if constexpr (NI == NO) {
+            for (; i + 64/NI <= nitems; i += 64/NI) {
+                __m512i v = _mm512_loadu_si512(in + i*NI);
+                _mm512_storeu_si512(out + i*NO, _mm512_shuffle_epi8(v, min));
+            }
+        } else if constexpr (NI == 8) {
+            for (; i + 8 <= nitems; i += 8) {
+                __m512i v = _mm512_loadu_si512(in + i*NI);
+                if constexpr (SwapIn) { v = _mm512_shuffle_epi8(v, min); }
+                __m256i r = _mm256_castps_si256(_mm512_cvtpd_ps(_mm512_castsi512_pd(v)));
+                if constexpr (SwapOut) {
+                    r = _mm256_shuffle_epi8(r, _mm512_castsi512_si256(mout));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i*NO), r);
+            }
+        } else {
+            for (; i + 8 <= nitems; i += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i*NI));
+                if constexpr (SwapIn) { v = _mm256_shuffle_epi8(v, _mm512_castsi512_si256(min)); }
+                __m512i r = _mm512_castpd_si512(_mm512_cvtps_pd(_mm256_castsi256_ps(v)));
+                if constexpr (SwapOut) { r = _mm512_shuffle_epi8(r, mout); }
+                _mm512_storeu_si512(out + i*NO, r);
+            }
+        }
+    }
+#endif
+
+#if defined(__AVX2__)
+    {
+        const __m256i min = _mm256_broadcastsi128_si256(ieee_bswap_mask<NI>());
+        const __m256i mout = _mm256_broadcastsi128_si256(ieee_bswap_mask<NO>());
+        if constexpr (NI == NO) {
+            for (; i + 32/NI <= nitems; i += 32/NI) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i*NI));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i*NO),
+                                    _mm256_shuffle_epi8(v, min));
+            }
+        } else if constexpr (NI == 8) {
+            for (; i + 4 <= nitems; i += 4) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i*NI));
+                if constexpr (SwapIn) { v = _mm256_shuffle_epi8(v, min); }
+                __m128i r = _mm_castps_si128(_mm256_cvtpd_ps(_mm256_castsi256_pd(v)));
+                if constexpr (SwapOut) { r = _mm_shuffle_epi8(r, _mm256_castsi256_si128(mout)); }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*NO), r);
+            }
+        } else {
+            for (; i + 4 <= nitems; i += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*NI));
+                if constexpr (SwapIn) { v = _mm_shuffle_epi8(v, _mm256_castsi256_si128(min)); }
+                __m256i r = _mm256_castpd_si256(_mm256_cvtps_pd(_mm_castsi128_ps(v)));
+                if constexpr (SwapOut) { r = _mm256_shuffle_epi8(r, mout); }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i*NO), r);
+            }
+        }
+    }
+#endif
+
+    for (; i < nitems; ++i) {
+        UIn ui;
+        std::memcpy(&ui, in + i*NI, NI);
+        if constexpr (SwapIn) { ui = ieee_bswap(ui); }
+        UOut uo;
+        if constexpr (NI == NO) {
+            uo = ui;
+        } else {
+            TIn x;
+            std::memcpy(&x, &ui, NI);
+            auto y = static_cast<TOut>(x);
+            std::memcpy(&uo, &y, NO);
+        }
+        if constexpr (SwapOut) { uo = ieee_bswap(uo); }
+        std::memcpy(out + i*NO, &uo, NO);
+    }
+}
+
+//
+// Returns 4 or 8 if rd is an IEEE real in native or reversed byte order,
+// and 0 otherwise.  Sets swapped for the reversed byte order.
+//
+
+static
+int
+ieee_kind (const RealDescriptor& rd, bool& swapped)
+{
+    for (const RealDescriptor* nd : {&FPC::Native32RealDescriptor(),
+                                     &FPC::Native64RealDescriptor()})
+    {
+        if (rd.formatarray() != nd->formatarray()) { continue; }
+        const int nb = nd->numBytes();
+        const Vector<int>& no = nd->orderarray();
+        const Vector<int>& ro = rd.orderarray();
+        if (ro.size() != nb) { return 0; }
+        bool same = true, reversed = true;
+        for (int i = 0; i < nb; ++i) {
+            same     = same     && (ro[i] == no[i]);
+            reversed = reversed && (ro[i] == no[nb-1-i]);
+        }
+        if (!same && !reversed) { return 0; }
+        swapped = !same;
+        return nb;
+    }
+    return 0;
+}
+
+template <typename TIn, typename TOut>
+static
+void
+ieee_convert (void* out, const void* in, Long nitems, bool swap_in, bool swap_out)
+{
+    auto*       pout = static_cast<char*>(out);
+    const auto* pin  = static_cast<const char*>(in);
+    if (swap_in) {
+        if (swap_out) {
+            ieee_convert<TIn,TOut,true,true>(pout, pin, nitems);
+        } else {
+            ieee_convert<TIn,TOut,true,false>(pout, pin, nitems);
+        }
+    } else {
+        if (swap_out) {
+            ieee_convert<TIn,TOut,false,true>(pout, pin, nitems);
+        } else {
+            ieee_convert<TIn,TOut,false,false>(pout, pin, nitems);
+        }
+    }
+}
+
+//
+// Convert with one of the fast paths.  Returns false if there is none.
+//
+
+static
+bool
+PD_convert_ieee (void*                 out,
+                 const void*           in,
+                 Long                  nitems,
+                 const RealDescriptor& ord,
+                 const RealDescriptor& ird)
+{
+    bool swap_out = false, swap_in = false;
+    const int nbo = ieee_kind(ord, swap_out);
+    const int nbi = ieee_kind(ird, swap_in);
+    if (nbo == 0 || nbi == 0) {
+        return false;
+    }
+    if (nbi == nbo && swap_in == swap_out) {
+        std::memcpy(out, in, nitems*nbi);
+    } else if (nbi == 8 && nbo == 8) {
+        ieee_convert<double,double>(out, in, nitems, swap_in, swap_out);
+    } else if (nbi == 4 && nbo == 4) {
+        ieee_convert<float,float>(out, in, nitems, swap_in, swap_out);
+    } else if (nbi == 8) {
+        ieee_convert<double,float>(out, in, nitems, swap_in, swap_out);
+    } else {
+        ieee_convert<float,double>(out, in, nitems, swap_in, swap_out);
+    }
+    return true;
+}
+
 static
 void
 PD_convert (void*                 out,
@@ -921,23 +1146,14 @@ PD_convert (void*                 out,
         BL_ASSERT(int(n) == nitems);
         memcpy(out, in, n*ord.numBytes());
     }
+    else if (boffs == 0 && ! onescmp && PD_convert_ieee(out, in, nitems, ord, ird))
+    {
+        // ---- done
+    }
     else if (ord.formatarray() == ird.formatarray() && boffs == 0 && ! onescmp) {
         permute_real_word_order(out, in, nitems,
                                 ord.order(), ird.order(), ord.numBytes());
     }
-    else if (ird == FPC::NativeRealDescriptor() && ord == FPC::Native32RealDescriptor()) {
-      const auto *rIn = static_cast<const char*>(in);
-      auto *rOut= static_cast<char*>(out);
-      for(Long i(0); i < nitems; ++i) {
-        Real x;
-        float y;
-        std::memcpy(&x, rIn, sizeof(Real));
-        y = static_cast<float>(x);
-        std::memcpy(rOut, &y, sizeof(float));
-        rOut += sizeof(float);
-        rIn += sizeof(Real);
-      }
-    }
     else
     {
         PD_fconvert(out, in, nitems, boffs, ord.format(), ord.order(),
@@ -2,7 +2,9 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_LayoutData.H>
 #include <AMReX_OpenMP.H>
+#include <AMReX_Utility.H>
 
 namespace amrex {
 
@@ -155,6 +157,9 @@ MFIter::MFIter (const BoxArray& ba, const DistributionMapping& dm, const MFItInf
     flags(info.do_tiling ? Tiling : 0),
     streams(std::max(1,std::min(Gpu::numGpuStreams(),info.num_streams))),
     dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    region(info.region),
+    region_ngrow(info.region_ngrow),
+    m_costs(info.costs),
     device_sync(info.device_sync),
     index_map(nullptr),
     local_index_map(nullptr),
@@ -187,6 +192,9 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
     flags(info.do_tiling ? Tiling : 0),
     streams(std::max(1,std::min(Gpu::numGpuStreams(),info.num_streams))),
     dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    region(info.region),
+    region_ngrow(info.region_ngrow),
+    m_costs(info.costs),
     device_sync(info.device_sync),
     index_map(nullptr),
     local_index_map(nullptr),
@@ -219,6 +227,11 @@ MFIter::Finalize ()
     if (finalized) return;
     finalized = true;
 
+    // the loop was left early
+    if (m_costs && isValid()) {
+        chargeCost();
+    }
+
     // mark as invalid
     currentIndex = endIndex;
 
@@ -282,6 +295,7 @@ MFIter::Initialize ()
 
     if (flags & AllBoxes)  // a very special case
     {
+        AMREX_ASSERT(region == FabArrayBase::TileRegion::all);
         index_map    = &(fabArray.IndexArray());
         currentIndex = 0;
         beginIndex   = 0;
@@ -289,7 +303,7 @@ MFIter::Initialize ()
     }
     else
     {
-        const FabArrayBase::TileArray* pta = fabArray.getTileArray(tile_size);
+        const FabArrayBase::TileArray* pta = fabArray.getTileArray(tile_size, region, region_ngrow);
 
         index_map            = &(pta->indexMap);
         local_index_map      = &(pta->localIndexMap);
@@ -367,9 +381,31 @@ MFIter::Initialize ()
 #endif
 
         typ = fabArray.boxArray().ixType();
+
+        if (m_costs) {
+            AMREX_ASSERT(m_costs->DistributionMap() == fabArray.DistributionMap() &&
+                         m_costs->boxArray() == fabArray.boxArray());
+            m_cost_t0 = amrex::second();
+        }
     }
 }
 
+void
+MFIter::chargeCost () noexcept
+{
+#ifdef AMREX_USE_GPU
+    Gpu::streamSynchronize();
+#endif
+    const double t = amrex::second();
+    Real& cost = (*m_costs)[*this];
+    const auto dt = static_cast<Real>(t - m_cost_t0);
+#ifdef AMREX_USE_OMP
+#pragma omp atomic
+#endif
+    cost += dt;
+    m_cost_t0 = t;
+}
+
 Box
 MFIter::tilebox () const noexcept
 {
@@ -510,6 +546,10 @@ MFIter::grownnodaltilebox (int dir, IntVect const& a_ng) const noexcept
 void
 MFIter::operator++ () noexcept
 {
+    if (m_costs) {
+        chargeCost();
+    }
+
 #ifdef AMREX_USE_OMP
     if (dynamic)
     {
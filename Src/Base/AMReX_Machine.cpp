@@ -2,8 +2,20 @@
 
 #ifndef AMREX_USE_MPI
 
+#include <AMReX_Machine.H>
+
 namespace amrex::machine {
     void Initialize () {}
+
+    const Vector<int>& node_of_rank () {
+        static const Vector<int> r{0};
+        return r;
+    }
+
+    const Vector<int>& socket_of_rank () {
+        static const Vector<int> r{0};
+        return r;
+    }
 }
 
 #else
@@ -14,6 +26,10 @@ namespace amrex::machine {
 #include <AMReX_Utility.H>
 #include <AMReX_Machine.H>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -575,17 +591,74 @@ class Machine
 
 std::unique_ptr<Machine> the_machine;
 
+Vector<int> the_node_of_rank;
+Vector<int> the_socket_of_rank;
+
+int get_my_socket ()
+{
+    int result = 0;
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        std::ifstream ifs("/sys/devices/system/cpu/cpu" + std::to_string(cpu)
+                          + "/topology/physical_package_id");
+        if (!(ifs >> result) || result < 0) {
+            result = 0;
+        }
+    }
+#endif
+    return result;
+}
+
+// collective over ALL ranks in the job
+void get_topology ()
+{
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+    int nprocs = ParallelDescriptor::NProcs();
+
+    // The lowest rank on each node identifies it.
+    int leader = ParallelDescriptor::MyProc();
+    MPI_Allreduce(MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, ParallelDescriptor::CommunicatorNode());
+
+    Vector<int> leaders(nprocs);
+    MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, comm);
+
+    the_node_of_rank.resize(nprocs);
+    std::map<int,int> node_id;
+    for (int i = 0; i < nprocs; ++i) {
+        auto r = node_id.emplace(leaders[i], static_cast<int>(node_id.size()));
+        the_node_of_rank[i] = r.first->second;
+    }
+
+    int socket = get_my_socket();
+    the_socket_of_rank.resize(nprocs);
+    MPI_Allgather(&socket, 1, MPI_INT, the_socket_of_rank.data(), 1, MPI_INT, comm);
+}
+
 }
 
 namespace amrex::machine {
 
 void Initialize () {
     the_machine = std::make_unique<Machine>();
+    get_topology();
     amrex::ExecOnFinalize(machine::Finalize);
 }
 
 void Finalize () {
     the_machine.reset();
+    the_node_of_rank.clear();
+    the_socket_of_rank.clear();
+}
+
+const Vector<int>& node_of_rank () {
+    AMREX_ASSERT(!the_node_of_rank.empty());
+    return the_node_of_rank;
+}
+
+const Vector<int>& socket_of_rank () {
+    AMREX_ASSERT(!the_socket_of_rank.empty());
+    return the_socket_of_rank;
 }
 
 Vector<int> find_best_nbh (int rank_n, bool flag_local_ranks) {
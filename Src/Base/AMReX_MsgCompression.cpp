@@ -0,0 +1,308 @@
+#include <AMReX_MsgCompression.H>
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace amrex::MsgCompression {
+
+namespace {
+
+    // codec (1 byte), padding, and a double parameter
+    constexpr std::size_t header_size = 16;
+
+    // Each chunk of the quantizer has its own minimum and code width.
+    constexpr std::size_t quantize_chunk = 1024;
+
+    template <typename T>
+    using UInt = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+    template <typename U>
+    int leading_zero_bytes (U d)
+    {
+        int lz = 0;
+        for (int b = sizeof(U)-1; b >= 0 && ((d >> (8*b)) & 0xff) == 0; --b) {
+            ++lz;
+        }
+        return lz;
+    }
+
+    // Messages may not be aligned for T, so values are loaded and stored
+    // with memcpy.
+    template <typename T>
+    T load (char const* p, std::size_t i)
+    {
+        T v;
+        std::memcpy(&v, p + i*sizeof(T), sizeof(T));
+        return v;
+    }
+
+    template <typename T>
+    void store (char* p, std::size_t i, T v)
+    {
+        std::memcpy(p + i*sizeof(T), &v, sizeof(T));
+    }
+
+    template <typename T>
+    std::size_t float32_encode (char const* in, std::size_t n, char* out, std::size_t cap)
+    {
+        if (sizeof(T) <= sizeof(float) || n*sizeof(float) > cap) { return 0; }
+        for (std::size_t i = 0; i < n; ++i) {
+            const T v = load<T>(in, i);
+            if (std::isfinite(v) && std::abs(v) > static_cast<T>(FLT_MAX)) {
+                return 0;
+            }
+            store(out, i, static_cast<float>(v));
+        }
+        return n*sizeof(float);
+    }
+
+    template <typename T>
+    void float32_decode (char const* in, char* out, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            store(out, i, static_cast<T>(load<float>(in, i)));
+        }
+    }
+
+    // Used by both the encoder and the decoder, so that the encoder can
+    // check the error of what will be decoded.
+    template <typename T>
+    T dequantize (double lo, std::uint32_t q, double step)
+    {
+        return static_cast<T>(lo + q*step);
+    }
+
+    // A chunk is a width byte, followed by the raw values if the width is
+    // 0, or by the minimum as double and the codes otherwise.  A chunk with
+    // a value that would not decode to within tol is stored raw.
+    template <typename T>
+    std::size_t quantize_encode (char const* in, std::size_t n, double tol, double step,
+                                 char* out, std::size_t cap)
+    {
+        if (!(step > 0.0)) { return 0; }
+        std::size_t pos = 0;
+        for (std::size_t s = 0; s < n; s += quantize_chunk)
+        {
+            const std::size_t m = std::min(quantize_chunk, n-s);
+            char const* v = in + s*sizeof(T);
+
+            bool finite = true;
+            double lo = 0.0, hi = 0.0;
+            for (std::size_t i = 0; i < m; ++i) {
+                const auto x = double(load<T>(v, i));
+                if (!std::isfinite(x)) { finite = false; break; }
+                lo = (i == 0) ? x : std::min(lo, x);
+                hi = (i == 0) ? x : std::max(hi, x);
+            }
+
+            int width = 0;
+            if (finite) {
+                const double qmax = std::ceil((hi-lo)/step);
+                if (qmax < 255.) {
+                    width = 1;
+                } else if (qmax < 65535.) {
+                    width = 2;
+                } else if (qmax < 4294967295. && sizeof(T) > 4) {
+                    width = 4;
+                }
+            }
+
+            const std::size_t chunk_pos = pos;
+            if (width > 0) {
+                if (pos + 1 + sizeof(double) + m*width > cap) { return 0; }
+                out[pos++] = static_cast<char>(width);
+                std::memcpy(out+pos, &lo, sizeof(double));
+                pos += sizeof(double);
+                for (std::size_t i = 0; i < m; ++i) {
+                    const T x = load<T>(v, i);
+                    auto q = static_cast<std::uint32_t>(std::llround((double(x)-lo)/step));
+                    if (!(std::abs(double(dequantize<T>(lo, q, step)) - double(x)) <= tol)) {
+                        width = 0;
+                        pos = chunk_pos;
+                        break;
+                    }
+                    for (int b = 0; b < width; ++b) {
+                        out[pos++] = static_cast<char>((q >> (8*b)) & 0xff);
+                    }
+                }
+            }
+            if (width == 0) {
+                if (pos + 1 + m*sizeof(T) > cap) { return 0; }
+                out[pos++] = 0;
+                std::memcpy(out+pos, v, m*sizeof(T));
+                pos += m*sizeof(T);
+            }
+        }
+        return pos;
+    }
+
+    template <typename T>
+    void quantize_decode (char const* in, double step, char* out, std::size_t n)
+    {
+        std::size_t pos = 0;
+        for (std::size_t s = 0; s < n; s += quantize_chunk)
+        {
+            const std::size_t m = std::min(quantize_chunk, n-s);
+            const int width = static_cast<unsigned char>(in[pos++]);
+            if (width == 0) {
+                std::memcpy(out+s*sizeof(T), in+pos, m*sizeof(T));
+                pos += m*sizeof(T);
+            } else {
+                double lo;
+                std::memcpy(&lo, in+pos, sizeof(double));
+                pos += sizeof(double);
+                for (std::size_t i = 0; i < m; ++i) {
+                    std::uint32_t q = 0;
+                    for (int b = 0; b < width; ++b) {
+                        q |= std::uint32_t(static_cast<unsigned char>(in[pos++])) << (8*b);
+                    }
+                    store(out, s+i, dequantize<T>(lo, q, step));
+                }
+            }
+        }
+    }
+
+    // Each pair of values is a control byte with the number of leading
+    // zero bytes of each value XORed with the previous one, followed by
+    // the remaining bytes of the two.
+    template <typename T>
+    std::size_t lossless_encode (char const* in, std::size_t n, char* out, std::size_t cap)
+    {
+        using U = UInt<T>;
+        U prev = 0;
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            if (pos + 1 + 2*sizeof(U) > cap) { return 0; }
+            const std::size_t ctrl_pos = pos++;
+            unsigned char ctrl = 0;
+            for (std::size_t h = 0; h < 2 && i+h < n; ++h) {
+                const U x = load<U>(in, i+h);
+                const U d = x ^ prev;
+                prev = x;
+                const int lz = leading_zero_bytes(d);
+                ctrl |= static_cast<unsigned char>(lz << (4*h));
+                for (int b = 0; b < int(sizeof(U))-lz; ++b) {
+                    out[pos++] = static_cast<char>((d >> (8*b)) & 0xff);
+                }
+            }
+            out[ctrl_pos] = static_cast<char>(ctrl);
+        }
+        return pos;
+    }
+
+    template <typename T>
+    void lossless_decode (char const* in, char* out, std::size_t n)
+    {
+        using U = UInt<T>;
+        U prev = 0;
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < n; i += 2)
+        {
+            const auto ctrl = static_cast<unsigned char>(in[pos++]);
+            for (std::size_t h = 0; h < 2 && i+h < n; ++h) {
+                const int lz = (ctrl >> (4*h)) & 0xf;
+                U d = 0;
+                for (int b = 0; b < int(sizeof(U))-lz; ++b) {
+                    d |= U(static_cast<unsigned char>(in[pos++])) << (8*b);
+                }
+                prev ^= d;
+                store(out, i+h, prev);
+            }
+        }
+    }
+
+    template <typename T>
+    std::size_t compress_t (Codec codec, double tol, double param, char const* src,
+                            std::size_t nbytes, char* dst, std::size_t dst_cap)
+    {
+        const std::size_t n = nbytes / sizeof(T);
+        char* out = dst + header_size;
+        const std::size_t cap = dst_cap - header_size;
+        std::size_t r = 0;
+        switch (codec) {
+        case Codec::float32 : r = float32_encode<T>(src, n, out, cap); break;
+        case Codec::quantize: r = quantize_encode<T>(src, n, tol, param, out, cap); break;
+        case Codec::lossless: r = lossless_encode<T>(src, n, out, cap); break;
+        default: break;
+        }
+        return (r == 0) ? 0 : r + header_size;
+    }
+
+    template <typename T>
+    void decompress_t (Codec codec, double param, char const* src, char* dst, std::size_t dst_bytes)
+    {
+        const std::size_t n = dst_bytes / sizeof(T);
+        switch (codec) {
+        case Codec::float32 : float32_decode<T>(src, dst, n); break;
+        case Codec::quantize: quantize_decode<T>(src, param, dst, n); break;
+        case Codec::lossless: lossless_decode<T>(src, dst, n); break;
+        default: amrex::Abort("MsgCompression::decompress: unknown codec");
+        }
+    }
+}
+
+Codec
+toCodec (std::string const& name)
+{
+    if (name == "none") {
+        return Codec::none;
+    } else if (name == "float32") {
+        return Codec::float32;
+    } else if (name == "quantize") {
+        return Codec::quantize;
+    } else if (name == "lossless") {
+        return Codec::lossless;
+    } else {
+        amrex::Abort("MsgCompression: unknown codec " + name);
+        return Codec::none;
+    }
+}
+
+std::size_t
+compress (Codec codec, Real tol, int elem_size, char const* src, std::size_t nbytes,
+          char* dst, std::size_t dst_cap)
+{
+    if (codec == Codec::none || dst_cap <= header_size) { return 0; }
+
+    // The quantization step is a little under twice the error bound, so
+    // that rounding rarely pushes the error over it.
+    const double param = (codec == Codec::quantize) ? 2.0*double(tol)*(1.0-1.e-6) : 0.0;
+
+    std::size_t r = 0;
+    if (elem_size == sizeof(double)) {
+        r = compress_t<double>(codec, double(tol), param, src, nbytes, dst, dst_cap);
+    } else if (elem_size == sizeof(float)) {
+        r = compress_t<float>(codec, double(tol), param, src, nbytes, dst, dst_cap);
+    }
+
+    if (r > 0) {
+        std::memset(dst, 0, header_size);
+        dst[0] = static_cast<char>(codec);
+        std::memcpy(dst+8, &param, sizeof(double));
+    }
+    return r;
+}
+
+void
+decompress (int elem_size, char const* src, std::size_t nbytes, char* dst, std::size_t dst_bytes)
+{
+    AMREX_ALWAYS_ASSERT(nbytes >= header_size);
+    const auto codec = static_cast<Codec>(src[0]);
+    double param;
+    std::memcpy(&param, src+8, sizeof(double));
+
+    if (elem_size == sizeof(double)) {
+        decompress_t<double>(codec, param, src+header_size, dst, dst_bytes);
+    } else {
+        decompress_t<float>(codec, param, src+header_size, dst, dst_bytes);
+    }
+}
+
+}
@@ -67,6 +67,9 @@ namespace amrex::ParallelDescriptor {
 
     int m_nprocs_per_node = 1;
 
+    MPI_Comm m_node_comm = MPI_COMM_NULL;  // ranks on this node
+    Vector<int> m_node_rank;               // rank in m_node_comm of each rank, or -1
+
 #ifdef AMREX_USE_MPI
     Vector<MPI_Datatype*> m_mpi_types;
     Vector<MPI_Op*> m_mpi_ops;
@@ -330,10 +333,19 @@ StartParallel (int* argc, char*** argv, MPI_Comm a_mpi_comm)
 #else
     int split_type = MPI_COMM_TYPE_SHARED;
 #endif
-    MPI_Comm node_comm;
-    MPI_Comm_split_type(m_comm, split_type, 0, MPI_INFO_NULL, &node_comm);
-    MPI_Comm_size(node_comm, &m_nprocs_per_node);
-    MPI_Comm_free(&node_comm);
+    MPI_Comm_split_type(m_comm, split_type, 0, MPI_INFO_NULL, &m_node_comm);
+    MPI_Comm_size(m_node_comm, &m_nprocs_per_node);
+    {
+        int nprocs, myproc;
+        MPI_Comm_size(m_comm, &nprocs);
+        MPI_Comm_rank(m_comm, &myproc);
+        Vector<int> node_members(m_nprocs_per_node);
+        MPI_Allgather(&myproc, 1, MPI_INT, node_members.data(), 1, MPI_INT, m_node_comm);
+        m_node_rank.assign(nprocs, -1);
+        for (int i = 0; i < m_nprocs_per_node; ++i) {
+            m_node_rank[node_members[i]] = i;
+        }
+    }
 
     // Create these types outside OMP parallel region
     auto t1 = Mpi_typemap<IntVect>::type(); // NOLINT
@@ -347,10 +359,10 @@ StartParallel (int* argc, char*** argv, MPI_Comm a_mpi_comm)
     // For Open MPI, calling this with subcommunicators will fail.
     // So we use MPI_COMM_WORLD here.
     BL_MPI_REQUIRE( MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &p, &flag) );
-    m_MaxTag = *p;
     if(!flag) {
         amrex::Abort("MPI_Comm_get_attr() failed to get MPI_TAG_UB");
     }
+    m_MaxTag = *p - NumReservedTags;
     BL_COMM_PROFILE_TAGRANGE(m_MinTag, m_MaxTag);
 
 #ifdef BL_USE_MPI3
@@ -390,6 +402,9 @@ EndParallel ()
         m_mpi_ops.clear();
     }
 
+    BL_MPI_REQUIRE( MPI_Comm_free(&m_node_comm) );
+    m_node_rank.clear();
+
     if (!call_mpi_finalize) {
         BL_MPI_REQUIRE( MPI_Comm_free(&m_comm) );
     }
@@ -1604,6 +1619,57 @@ alignof_comm_data (std::size_t nbytes)
     }
 }
 
+namespace {
+    // Datatype and count for a message of nbytes bytes at buf.  See
+    // select_comm_data_type.
+    std::pair<MPI_Datatype,int>
+    comm_data_type_count (const char* buf, std::size_t nbytes)
+    {
+        const int comm_data_type = ParallelDescriptor::select_comm_data_type(nbytes);
+        if (comm_data_type == 1) {
+            return {Mpi_typemap<char>::type(), static_cast<int>(nbytes)};
+        } else if (comm_data_type == 2) {
+            if (!amrex::is_aligned(buf, alignof(unsigned long long))
+                || (nbytes % sizeof(unsigned long long)) != 0) {
+                amrex::Abort("Message size is too big as char, and it cannot be sent as unsigned long long.");
+            }
+            return {Mpi_typemap<unsigned long long>::type(),
+                    static_cast<int>(nbytes/sizeof(unsigned long long))};
+        } else if (comm_data_type == 3) {
+            if (!amrex::is_aligned(buf, alignof(ParallelDescriptor::lull_t))
+                || (nbytes % sizeof(ParallelDescriptor::lull_t)) != 0) {
+                amrex::Abort("Message size is too big as char or unsigned long long, and it cannot be sent as ParallelDescriptor::lull_t");
+            }
+            return {Mpi_typemap<ParallelDescriptor::lull_t>::type(),
+                    static_cast<int>(nbytes/sizeof(ParallelDescriptor::lull_t))};
+        } else {
+            amrex::Abort("TODO: message size is too big");
+            return {Mpi_typemap<char>::type(), 0};
+        }
+    }
+}
+
+MPI_Request
+Send_init (const char* buf, std::size_t n, int pid, int tag, MPI_Comm comm)
+{
+    BL_PROFILE("ParallelDescriptor::Send_init()");
+    auto [datatype, count] = comm_data_type_count(buf, n);
+    MPI_Request req;
+    BL_MPI_REQUIRE( MPI_Send_init(const_cast<char*>(buf), count, datatype,
+                                  pid, tag, comm, &req) );
+    return req;
+}
+
+MPI_Request
+Recv_init (char* buf, std::size_t n, int pid, int tag, MPI_Comm comm)
+{
+    BL_PROFILE("ParallelDescriptor::Recv_init()");
+    auto [datatype, count] = comm_data_type_count(buf, n);
+    MPI_Request req;
+    BL_MPI_REQUIRE( MPI_Recv_init(buf, count, datatype, pid, tag, comm, &req) );
+    return req;
+}
+
 template <>
 Message
 Asend<char> (const char* buf, size_t n, int pid, int tag, MPI_Comm comm)
@@ -0,0 +1,190 @@
+#include <AMReX_PhaseArena.H>
+#include <AMReX.H>
+#include <AMReX_Gpu.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+
+namespace amrex {
+
+namespace {
+    bool use_phase_arena = false;
+    std::vector<PhaseArena*> phase_arenas;
+    std::vector<Arena*> phase_arena_bases;
+}
+
+void
+PhaseArena::Initialize ()
+{
+    use_phase_arena = false;
+    ParmParse pp("amrex");
+    pp.queryAdd("use_phase_arena", use_phase_arena);
+}
+
+Arena*
+PhaseArena::Current (Arena* base)
+{
+    for (auto i = phase_arenas.size(); i > 0; --i) {
+        if (phase_arena_bases[i-1] == base) {
+            return phase_arenas[i-1];
+        }
+    }
+    return base;
+}
+
+PhaseArena::PhaseArena (std::string name, Arena* base, std::size_t slab_size)
+    : m_name(std::move(name)),
+      m_base(base),
+      m_slab_size(Arena::align(slab_size))
+{
+    arena_info = m_base->arenaInfo();
+    m_active = use_phase_arena;
+    if (m_active) {
+        AMREX_ALWAYS_ASSERT(!OpenMP::in_parallel());
+        phase_arenas.push_back(this);
+        phase_arena_bases.push_back(m_base);
+    }
+}
+
+PhaseArena::~PhaseArena ()
+{
+    if (!m_active) { return; }
+
+    AMREX_ALWAYS_ASSERT(!phase_arenas.empty() && phase_arenas.back() == this);
+    phase_arenas.pop_back();
+    phase_arena_bases.pop_back();
+
+    // The blocks of an Elixir are freed once the stream is done.
+    Gpu::streamSynchronizeAll();
+
+    if (!m_busylist.empty()) {
+        amrex::Abort("PhaseArena " + m_name + ": " + std::to_string(m_busylist.size())
+                     + " blocks are still in use at the end of the phase");
+    }
+
+    for (auto* p : m_slabs) {
+        m_base->free(p);
+    }
+
+    if (amrex::system::verbose > 1) {
+        amrex::Print() << "PhaseArena " << m_name << ": " << m_nalloc << " allocations, "
+                       << m_nreused << " reused, " << m_slabs.size() << " slabs, hwm "
+                       << m_nbytes_hwm << " bytes\n";
+    }
+}
+
+void*
+PhaseArena::alloc (std::size_t nbytes)
+{
+    if (!m_active) {
+        return m_base->alloc(nbytes);
+    }
+
+    nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ++m_nalloc;
+
+    void* p = nullptr;
+    if (nbytes > m_slab_size/2) {
+        p = m_base->alloc(nbytes);
+        m_busylist.emplace(p, std::make_pair(nbytes, false));
+        m_nbytes += nbytes;
+        m_nbytes_hwm = std::max(m_nbytes_hwm, m_nbytes);
+        return p;
+    }
+
+    // A freed block wasting no more than half of it.
+    auto it = m_freelist.lower_bound(nbytes);
+    if (it != m_freelist.end() && it->first <= 2*nbytes) {
+        p = it->second;
+        m_busylist.emplace(p, std::make_pair(it->first, true));
+        m_nbytes += it->first;
+        m_nbytes_hwm = std::max(m_nbytes_hwm, m_nbytes);
+        m_freelist.erase(it);
+        ++m_nreused;
+        return p;
+    }
+
+    if (m_room < nbytes) {
+        // The rest of the current slab becomes a free block.
+        if (m_room > 0) {
+            m_freelist.emplace(m_room, m_top);
+        }
+        m_top = static_cast<char*>(m_base->alloc(m_slab_size));
+        m_room = m_slab_size;
+        m_slabs.push_back(m_top);
+    }
+
+    p = m_top;
+    m_top += nbytes;
+    m_room -= nbytes;
+    m_busylist.emplace(p, std::make_pair(nbytes, true));
+    m_nbytes += nbytes;
+    m_nbytes_hwm = std::max(m_nbytes_hwm, m_nbytes);
+    return p;
+}
+
+void
+PhaseArena::free (void* p)
+{
+    if (p == nullptr) { return; }
+
+    if (!m_active) {
+        m_base->free(p);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_busylist.find(p);
+    if (it == m_busylist.end()) {
+        amrex::Abort("PhaseArena::free: unknown pointer");
+        return;
+    }
+
+    const auto [nbytes, in_slab] = it->second;
+    m_busylist.erase(it);
+    m_nbytes -= nbytes;
+
+    if (in_slab) {
+        m_freelist.emplace(nbytes, p);
+    } else {
+        m_base->free(p);
+    }
+}
+
+bool
+PhaseArena::isDeviceAccessible () const
+{
+    return m_base->isDeviceAccessible();
+}
+
+bool
+PhaseArena::isHostAccessible () const
+{
+    return m_base->isHostAccessible();
+}
+
+bool
+PhaseArena::isManaged () const
+{
+    return m_base->isManaged();
+}
+
+bool
+PhaseArena::isDevice () const
+{
+    return m_base->isDevice();
+}
+
+bool
+PhaseArena::isPinned () const
+{
+    return m_base->isPinned();
+}
+
+}
@@ -1,6 +1,10 @@
 #include <AMReX_PlotFileDataImpl.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#ifdef AMREX_USE_HDF5
+#include <AMReX_PlotFileDataHDF5.H>
+#endif
 #include <algorithm>
 
 namespace amrex {
@@ -11,11 +15,49 @@ namespace {
         constexpr std::streamsize bl_ignore_max { 100000 };
         is.ignore(bl_ignore_max, '\n');
     }
+
+#ifdef AMREX_USE_HDF5
+    bool IsHDF5Plotfile (std::string const& name)
+    {
+        if (name.size() >= 3 && name.compare(name.size()-3, 3, ".h5") == 0) {
+            return true;
+        }
+        return !amrex::FileExists(name+"/Header") && amrex::FileExists(name+".h5");
+    }
+#endif
 }
 
 PlotFileDataImpl::PlotFileDataImpl (std::string const& plotfile_name)
     : m_plotfile_name(plotfile_name)
 {
+#ifdef AMREX_USE_HDF5
+    if (IsHDF5Plotfile(plotfile_name)) {
+        // Only the metadata are read here.  Data are decoded by get().
+        m_hdf5 = std::make_unique<PlotFileDataHDF5>(plotfile_name, -1);
+        m_file_version = "HDF5";
+        m_ncomp = m_hdf5->nComp();
+        m_var_names = m_hdf5->varNames();
+        m_spacedim = m_hdf5->spaceDim();
+        m_time = m_hdf5->time();
+        m_finest_level = m_hdf5->finestLevel();
+        m_nlevels = m_finest_level+1;
+        m_prob_lo = m_hdf5->probLo();
+        m_prob_hi = m_hdf5->probHi();
+        m_prob_size = m_hdf5->probSize();
+        m_coordsys = m_hdf5->coordSys();
+        for (int ilev = 0; ilev < m_nlevels; ++ilev) {
+            m_ref_ratio.push_back(m_hdf5->refRatio(ilev));
+            m_prob_domain.push_back(m_hdf5->probDomain(ilev));
+            m_level_steps.push_back(m_hdf5->levelStep(ilev));
+            m_cell_size.push_back(m_hdf5->cellSize(ilev));
+            m_ba.push_back(m_hdf5->boxArray(ilev));
+            m_dmap.push_back(m_hdf5->DistributionMap(ilev));
+            m_ngrow.push_back(IntVect(0));
+        }
+        return;
+    }
+#endif
+
     // Header
     std::string File(plotfile_name+"/Header");
     Vector<char> fileCharPtr;
@@ -99,6 +141,18 @@ PlotFileDataImpl::PlotFileDataImpl (std::string const& plotfile_name)
     }
 }
 
+PlotFileDataImpl::~PlotFileDataImpl () = default;
+
+bool
+PlotFileDataImpl::isHDF5 () const noexcept
+{
+#ifdef AMREX_USE_HDF5
+    return m_hdf5 != nullptr;
+#else
+    return false;
+#endif
+}
+
 void
 PlotFileDataImpl::syncDistributionMap (PlotFileDataImpl const& src) noexcept
 {
@@ -120,6 +174,12 @@ MultiFab
 PlotFileDataImpl::get (int level) noexcept
 {
     MultiFab mf(m_ba[level], m_dmap[level], m_ncomp, m_ngrow[level]);
+#ifdef AMREX_USE_HDF5
+    if (m_hdf5) {
+        mf.ParallelCopy(m_hdf5->get(level));
+        return mf;
+    }
+#endif
     VisMF::Read(mf, m_mf_name[level]);
     return mf;
 }
@@ -133,12 +193,13 @@ PlotFileDataImpl::get (int level, std::string const& varname) noexcept
         amrex::Abort("PlotFileDataImpl::get: varname not found "+varname);
     } else {
         int icomp = static_cast<int>(std::distance(std::begin(m_var_names), r));
-        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-            int gid = mfi.index();
-            FArrayBox& dstfab = mf[mfi];
-            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
-            dstfab.copy<RunOn::Host>(*srcfab);
+#ifdef AMREX_USE_HDF5
+        if (m_hdf5) {
+            mf.ParallelCopy(m_hdf5->get(level), icomp, 0, 1);
+            return mf;
         }
+#endif
+        m_vismf[level]->ReadComponent(mf, icomp);
     }
     return mf;
 }
@@ -4,6 +4,7 @@
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_PhaseArena.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -169,6 +170,9 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
 {
     BL_PROFILE("WriteMultiLevelPlotfile()");
 
+    // For the buffers of VisMF::Write
+    PhaseArena phase_arena("WriteMultiLevelPlotfile", The_Cpu_Arena());
+
     BL_ASSERT(nlevels <= mf.size());
     BL_ASSERT(nlevels <= geom.size());
     BL_ASSERT(nlevels <= ref_ratio.size()+1);
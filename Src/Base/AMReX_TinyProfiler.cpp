@@ -927,6 +927,23 @@ TinyProfileRegion::~TinyProfileRegion ()
     TinyProfiler::StopRegion(regname);
 }
 
+const std::string&
+TinyProfiler::CurrentFunction () noexcept
+{
+    static const std::string unprofiled("Unprofiled");
+
+#ifdef AMREX_USE_OMP
+    if (omp_in_parallel() && !mem_stack_thread_private[omp_get_thread_num()].deque.empty()) {
+        return mem_stack_thread_private[omp_get_thread_num()].deque.back()->fname;
+    }
+#endif
+    if (!mem_stack.empty()) {
+        return mem_stack.back()->fname;
+    } else {
+        return unprofiled;
+    }
+}
+
 void
 TinyProfiler::PrintCallStack (std::ostream& os)
 {
@@ -2,13 +2,22 @@
 #include <AMReX_FabArrayUtility.H>
 #include <AMReX_FPC.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_PhaseArena.H>
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace amrex {
 
 static const char *TheMultiFabHdrFileSuffix = "_H";
@@ -28,6 +37,9 @@ bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
 bool VisMF::allowSparseWrites(true);
+bool VisMF::usePRead(true);
+bool VisMF::usePWrite(false);
+bool VisMF::useODirect(false);
 
 Long VisMFBuffer::ioBufferSize(VisMF::IO_Buffer_Size);
 
@@ -57,6 +69,103 @@ namespace
         }
     }
 #endif
+
+#ifndef _WIN32
+    void PReadFully (int fd, char* buf, Long nbytes, Long offset)
+    {
+        while (nbytes > 0) {
+            auto n = ::pread(fd, buf, nbytes, offset);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) { continue; }
+                amrex::Error("VisMF::ReadComponent: pread failed");
+            }
+            buf += n;
+            nbytes -= n;
+            offset += n;
+        }
+    }
+
+    // Read component icomp of the FAB that starts at head.  Returns false
+    // for old style FAB headers, which are left to VisMF::readFAB.
+    bool PReadFabComponent (int fd, Long head, bool has_fab_header,
+                            const RealDescriptor& hdr_rd, int icomp,
+                            Real* dst, Long npts)
+    {
+        RealDescriptor rd = hdr_rd;
+        Long offset = head;
+        if (has_fab_header) {
+            // The FAB header is a single line of text.
+            constexpr Long max_header = 1024;
+            char buf[max_header];
+            auto n = ::pread(fd, buf, max_header, head);
+            if (n <= 0) { return false; }
+            auto* nl = static_cast<char*>(std::memchr(buf, '\n', n));
+            if (nl == nullptr) { return false; }
+            std::istringstream is(std::string(buf, nl));
+            char f, a, b, c;
+            is >> f >> a >> b >> c;
+            if (f != 'F' || a != 'A' || b != 'B' || c == ':') { return false; }
+            is.putback(c);
+            Box bx;
+            int nvar;
+            is >> rd >> bx >> nvar;
+            if (is.fail() || icomp >= nvar) { return false; }
+            offset = head + (nl - buf) + 1;
+        }
+
+        const Long nbytes = npts * rd.numBytes();
+        offset += icomp * nbytes;
+        if (rd == FPC::NativeRealDescriptor()) {
+            PReadFully(fd, reinterpret_cast<char*>(dst), nbytes, offset);
+        } else {
+            Vector<char> tmp(nbytes);
+            PReadFully(fd, tmp.data(), nbytes, offset);
+            RealDescriptor::convertToNativeFormat(dst, npts, tmp.data(), rd);
+        }
+        return true;
+    }
+
+    void PWriteFully (int fd, const char* buf, Long nbytes, Long offset)
+    {
+        while (nbytes > 0) {
+            auto n = ::pwrite(fd, buf, nbytes, offset);
+            if (n < 0) {
+                if (errno == EINTR) { continue; }
+                amrex::Error("VisMF::PWriteFabs: pwrite failed");
+            }
+            buf += n;
+            nbytes -= n;
+            offset += n;
+        }
+    }
+
+    // Write [offset, offset+nbytes).  With a valid direct_fd, the part that
+    // is aligned to direct_align goes through aligned staging buffers of
+    // at most bufsize bytes, and the unaligned ends go through fd.
+    void PWriteRange (int fd, int direct_fd, const char* buf, Long nbytes, Long offset,
+                      Long bufsize)
+    {
+        constexpr Long direct_align = 4096;
+        const Long a0 = ((offset + direct_align - 1) / direct_align) * direct_align;
+        const Long a1 = ((offset + nbytes) / direct_align) * direct_align;
+        void* stage = nullptr;
+        bufsize = std::max(bufsize - bufsize % direct_align, direct_align);
+        if (direct_fd < 0 || a1 <= a0 ||
+            ::posix_memalign(&stage, direct_align, bufsize) != 0)
+        {
+            PWriteFully(fd, buf, nbytes, offset);
+            return;
+        }
+        PWriteFully(fd, buf, a0 - offset, offset);
+        for (Long pos = a0; pos < a1; pos += bufsize) {
+            const Long n = std::min(bufsize, a1 - pos);
+            std::memcpy(stage, buf + (pos - offset), n);
+            PWriteFully(direct_fd, static_cast<char*>(stage), n, pos);
+        }
+        std::free(stage);
+        PWriteFully(fd, buf + (a1 - offset), offset + nbytes - a1, a1);
+    }
+#endif
 }
 
 void
@@ -93,6 +202,9 @@ VisMF::Initialize ()
     pp.queryAdd("usedynamicsetselection", useDynamicSetSelection);
     pp.queryAdd("iobuffersize", ioBufferSize);
     pp.queryAdd("allowsparsewrites", allowSparseWrites);
+    pp.queryAdd("usepread", usePRead);
+    pp.queryAdd("usepwrite", usePWrite);
+    pp.queryAdd("useodirect", useODirect);
 
     initialized = true;
 }
@@ -548,6 +660,73 @@ VisMF::readFAB (int idx, const std::string& mf_name)
     return VisMF::readFAB(idx, mf_name, m_hdr, -1);
 }
 
+void
+VisMF::ReadComponent (FabArray<FArrayBox>& mf, int icomp, int dcomp) const
+{
+    BL_PROFILE("VisMF::ReadComponent");
+
+    AMREX_ALWAYS_ASSERT(mf.boxArray() == m_hdr.m_ba && mf.nGrowVect() == m_hdr.m_ngrow);
+    AMREX_ALWAYS_ASSERT(icomp >= 0 && icomp < m_hdr.m_ncomp && dcomp < mf.nComp());
+
+    Vector<int> todo;
+    for (int li = 0, N = mf.local_size(); li < N; ++li) {
+        todo.push_back(mf.IndexArray()[li]);
+    }
+
+#ifndef _WIN32
+    if (usePRead && !mf.arena()->isDevice()) {
+        const bool has_fab_header = !NoFabHeader(m_hdr);
+        const bool has_minmax = !m_hdr.m_min.empty() && m_hdr.m_ngrow == 0;
+        const std::string dir = VisMF::DirName(m_fafabname);
+
+        std::map<std::string,int> fds;
+        Vector<int> to_read;
+        for (int gid : todo) {
+            if (has_minmax && m_hdr.m_min[gid][icomp] == m_hdr.m_max[gid][icomp]) {
+                mf[gid].setVal<RunOn::Host>(m_hdr.m_min[gid][icomp], mf[gid].box(), dcomp, 1);
+                continue;
+            }
+            to_read.push_back(gid);
+            const std::string& fname = m_hdr.m_fod[gid].m_name;
+            if (fds.count(fname) == 0) {
+                int fd = ::open((dir+fname).c_str(), O_RDONLY);
+                if (fd < 0) {
+                    amrex::FileOpenFailed(dir+fname);
+                }
+                fds[fname] = fd;
+            }
+        }
+
+        const int nread = static_cast<int>(to_read.size());
+        Vector<char> done(nread, 0);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < nread; ++i) {
+            const int gid = to_read[i];
+            FArrayBox& fab = mf[gid];
+            done[i] = PReadFabComponent(fds.at(m_hdr.m_fod[gid].m_name), m_hdr.m_fod[gid].m_head,
+                                        has_fab_header, m_hdr.m_writtenRD, icomp,
+                                        fab.dataPtr(dcomp), fab.box().numPts());
+        }
+
+        for (auto const& kv : fds) {
+            ::close(kv.second);
+        }
+
+        todo.clear();
+        for (int i = 0; i < nread; ++i) {
+            if (!done[i]) { todo.push_back(to_read[i]); }
+        }
+    }
+#endif
+
+    for (int gid : todo) {
+        std::unique_ptr<FArrayBox> srcfab(VisMF::readFAB(gid, m_fafabname, m_hdr, icomp));
+        mf[gid].copy<RunOn::Host>(*srcfab, 0, dcomp, 1);
+    }
+}
+
 FArrayBox*
 VisMF::readFAB (int idx, int icomp)
 {
@@ -972,6 +1151,22 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
     std::string filePrefix(mf_name + FabFileSuffix);
 
+#ifndef _WIN32
+    if(usePWrite) {
+        bytesWritten += VisMF::PWriteFabs(mf, filePrefix, hdr, useSparseFPP);
+
+        if(currentVersion == VisMF::Header::Version_v1 ||
+           currentVersion == VisMF::Header::NoFabHeaderMinMax_v1)
+        {
+            hdr.CalculateMinMax(mf, coordinatorProc);
+        }
+
+        bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+        return bytesWritten;
+    }
+#endif
+
     NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
 
     bool oldHeader(currentVersion == VisMF::Header::Version_v1);
@@ -1074,13 +1269,14 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
                 }
 #endif
                 if(doConvert) {
-                    char *cDataPtr = new char[writeDataSize];
+                    Arena* ar = PhaseArena::Current(The_Cpu_Arena());
+                    char *cDataPtr = static_cast<char*>(ar->alloc(writeDataSize));
                     RealDescriptor::convertFromNativeFormat(static_cast<void *> (cDataPtr),
                                                             writeDataItems,
                                                             fabdata, *whichRD);
                     nfi.Stream().write(cDataPtr, writeDataSize);
                     nfi.Stream().flush();
-                    delete [] cDataPtr;
+                    ar->free(cDataPtr);
                 } else {    // ---- copy from the fab
                     nfi.Stream().write((char *) fabdata, writeDataSize);
                     nfi.Stream().flush();
@@ -1108,6 +1304,152 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 }
 
 
+Long
+VisMF::PWriteFabs (const FabArray<FArrayBox>& mf, const std::string& filePrefix,
+                   VisMF::Header& hdr, bool useSparseFPP)
+{
+#ifdef _WIN32
+    amrex::ignore_unused(mf, filePrefix, hdr, useSparseFPP);
+    amrex::Abort("VisMF::PWriteFabs: not supported on this platform");
+    return 0;
+#else
+    BL_PROFILE("VisMF::PWriteFabs");
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nProcs(ParallelDescriptor::NProcs());
+    const int nFiles(useSparseFPP ? nProcs : NFilesIter::ActualNFiles(nOutFiles));
+
+    auto whichRD = FArrayBox::getDataDescriptor();
+    const bool doConvert(*whichRD != FPC::NativeRealDescriptor());
+    const bool oldHeader(hdr.m_vers == VisMF::Header::Version_v1);
+    const FABio &fio = FArrayBox::getFABio();
+    const int nComps(mf.nComp());
+    const Long whichRDBytes(whichRD->numBytes());
+
+    // ---- every rank knows the offset of every fab:  the ranks of a file
+    // ---- follow each other in rank order, and the fabs of a rank in index order
+    const BoxArray &mfBA = mf.boxArray();
+    const DistributionMapping &mfDM = mf.DistributionMap();
+    Vector<Vector<int> > rankBoxOrder(nProcs);
+    for(int i(0); i < mfBA.size(); ++i) {
+        rankBoxOrder[mfDM[i]].push_back(i);
+    }
+
+    Vector<Long> fileSize(nFiles, 0);
+    Vector<int> fileLeader(nFiles, -1);
+    for(int rank(0); rank < nProcs; ++rank) {
+        if(rankBoxOrder[rank].empty()) {
+            continue;
+        }
+        const int fileNumber(useSparseFPP ? rank : NFilesIter::FileNumber(nFiles, rank, groupSets));
+        const std::string fileName(VisMF::BaseName(NFilesIter::FileName(fileNumber, filePrefix)));
+        if(fileLeader[fileNumber] < 0) {
+            fileLeader[fileNumber] = rank;
+        }
+        for(int i : rankBoxOrder[rank]) {
+            Long fabHeaderBytes(0);
+            if(oldHeader) {
+                std::stringstream hss;
+                FArrayBox tempFab(mf.fabbox(i), nComps, false);  // ---- no alloc
+                fio.write_header(hss, tempFab, tempFab.nComp());
+                fabHeaderBytes = static_cast<std::streamoff>(hss.tellp());
+            }
+            hdr.m_fod[i].m_name = fileName;
+            hdr.m_fod[i].m_head = fileSize[fileNumber];
+            fileSize[fileNumber] += fabHeaderBytes + mf.fabbox(i).numPts() * nComps * whichRDBytes;
+        }
+    }
+
+    // ---- the first rank of a file creates it with its final size
+    const int myFileNumber(useSparseFPP ? myProc : NFilesIter::FileNumber(nFiles, myProc, groupSets));
+    const std::string myFileName(NFilesIter::FileName(myFileNumber, filePrefix));
+    if(fileLeader[myFileNumber] == myProc) {
+        int fd = ::open(myFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) {
+            amrex::FileOpenFailed(myFileName);
+        }
+        if(::ftruncate(fd, fileSize[myFileNumber]) != 0) {
+            amrex::Error("VisMF::PWriteFabs: ftruncate failed for " + myFileName);
+        }
+        ::close(fd);
+    }
+    ParallelDescriptor::Barrier("VisMF::PWriteFabs");
+
+    Long bytesWritten(0);
+    if(rankBoxOrder[myProc].empty()) {
+        return bytesWritten;
+    }
+
+    int fd = ::open(myFileName.c_str(), O_WRONLY);
+    if(fd < 0) {
+        amrex::FileOpenFailed(myFileName);
+    }
+    int direct_fd(-1);
+#ifdef O_DIRECT
+    if(useODirect) {
+        direct_fd = ::open(myFileName.c_str(), O_WRONLY | O_DIRECT);
+    }
+#endif
+
+    // ---- the fabs of this rank are written by all threads at once
+    const Vector<int>& localFabs = rankBoxOrder[myProc];
+    const int nLocal(localFabs.size());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic) reduction(+:bytesWritten)
+#endif
+    for(int li = 0; li < nLocal; ++li) {
+        const int idx(localFabs[li]);
+        const FArrayBox &fab = mf[idx];
+        Long offset(hdr.m_fod[idx].m_head);
+        if(oldHeader) {
+            std::stringstream hss;
+            fio.write_header(hss, fab, fab.nComp());
+            const auto tstr = hss.str();
+            PWriteFully(fd, tstr.data(), tstr.size(), offset);
+            offset += tstr.size();
+            bytesWritten += tstr.size();
+        }
+
+        const Long writeDataItems(fab.box().numPts() * nComps);
+        const Long writeDataSize(writeDataItems * whichRDBytes);
+        Real const* fabdata = fab.dataPtr();
+#ifdef AMREX_USE_GPU
+        std::unique_ptr<FArrayBox> hostfab;
+        if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+            hostfab = std::make_unique<FArrayBox>(fab.box(), fab.nComp(),
+                                                  The_Pinned_Arena());
+            Gpu::dtoh_memcpy_async(hostfab->dataPtr(), fab.dataPtr(),
+                                   fab.size()*sizeof(Real));
+            Gpu::streamSynchronize();
+            fabdata = hostfab->dataPtr();
+        }
+#endif
+        if(doConvert) {
+            Arena* ar = PhaseArena::Current(The_Cpu_Arena());
+            char* cData = static_cast<char*>(ar->alloc(writeDataSize));
+            RealDescriptor::convertFromNativeFormat(static_cast<void *> (cData),
+                                                    writeDataItems,
+                                                    fabdata, *whichRD);
+            PWriteRange(fd, direct_fd, cData, writeDataSize, offset,
+                        VisMFBuffer::GetIOBufferSize());
+            ar->free(cData);
+        } else {
+            PWriteRange(fd, direct_fd, reinterpret_cast<const char*>(fabdata), writeDataSize,
+                        offset, VisMFBuffer::GetIOBufferSize());
+        }
+        bytesWritten += writeDataSize;
+    }
+
+    if(direct_fd >= 0) {
+        ::close(direct_fd);
+    }
+    ::close(fd);
+
+    return bytesWritten;
+#endif
+}
+
+
 Long
 VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
                         const std::string         & mf_name,
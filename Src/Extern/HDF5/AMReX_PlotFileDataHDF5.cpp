@@ -0,0 +1,506 @@
+#include <AMReX_PlotFileDataHDF5.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_IArrayBox.H>
+#include <AMReX_Loop.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace amrex {
+
+namespace {
+
+    hid_t MakeBoxType ()
+    {
+        hid_t box_id = H5Tcreate(H5T_COMPOUND, 2 * AMREX_SPACEDIM * sizeof(int));
+        const char* lo_names[] = {"lo_i", "lo_j", "lo_k"};
+        const char* hi_names[] = {"hi_i", "hi_j", "hi_k"};
+        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+            H5Tinsert(box_id, lo_names[i], i * sizeof(int), H5T_NATIVE_INT);
+        }
+        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+            H5Tinsert(box_id, hi_names[i], (AMREX_SPACEDIM + i) * sizeof(int), H5T_NATIVE_INT);
+        }
+        return box_id;
+    }
+
+    bool ReadHDF5Attr (hid_t loc, const char* name, hid_t type, void* data)
+    {
+        if (H5Aexists(loc, name) <= 0) { return false; }
+        hid_t attr = H5Aopen(loc, name, H5P_DEFAULT);
+        herr_t ret = H5Aread(attr, type, data);
+        H5Aclose(attr);
+        return ret >= 0;
+    }
+
+    std::string ReadHDF5AttrString (hid_t loc, const char* name)
+    {
+        std::string r;
+        if (H5Aexists(loc, name) <= 0) { return r; }
+        hid_t attr = H5Aopen(loc, name, H5P_DEFAULT);
+        hid_t atype = H5Aget_type(attr);
+        Vector<char> buf(H5Tget_size(atype)+1, '\0');
+        H5Aread(attr, atype, buf.data());
+        r = std::string(buf.data());
+        H5Tclose(atype);
+        H5Aclose(attr);
+        return r;
+    }
+
+    Vector<int> ReadHDF5DsetInt (hid_t loc, const char* name, hid_t type, int nper)
+    {
+        Vector<int> r;
+        if (H5Lexists(loc, name, H5P_DEFAULT) <= 0) { return r; }
+        hid_t dset = H5Dopen(loc, name, H5P_DEFAULT);
+        hid_t space = H5Dget_space(dset);
+        auto n = static_cast<Long>(H5Sget_simple_extent_npoints(space));
+        r.resize(n*nper);
+        if (n > 0) {
+            H5Dread(dset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, r.data());
+        }
+        H5Sclose(space);
+        H5Dclose(dset);
+        return r;
+    }
+
+    // Position of the t-th uncovered cell of a rank in its chunk.  This is
+    // the inverse of the packing done by the HDF5 plotfile writers.
+    Long AMRICIndex (AMRICLayout layout, Long t, Long bs, Long bigx)
+    {
+        if (layout == AMRICLayout::Nast) { return t; }
+        const Long unit = bs*bs*bs;
+        const Long b2 = bs*bs;
+        const Long big2 = bigx*bigx;
+        const Long cc = t/unit;
+        const Long zz = cc/big2;
+        const Long yy = (cc - zz*big2)/bigx;
+        const Long xx = cc - zz*big2 - yy*bigx;
+        const Long bb = t - unit*cc;
+        const Long kk = bb/b2;
+        const Long jj = (bb - kk*b2)/bs;
+        const Long ii = bb - kk*b2 - jj*bs;
+        return (xx*bs+ii) + (yy*bs+jj)*bs*bigx + (zz*bs+kk)*big2*b2;
+    }
+}
+
+PlotFileDataHDF5::PlotFileDataHDF5 (std::string const& plotfile_name, int preview_level)
+    : m_plotfile_name(plotfile_name)
+{
+    std::string filename(plotfile_name);
+    if (filename.size() < 3 || filename.compare(filename.size()-3, 3, ".h5") != 0) {
+        filename += ".h5";
+    }
+
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+#ifdef BL_USE_MPI
+    H5Pset_fapl_mpio(fapl, ParallelDescriptor::Communicator(), MPI_INFO_NULL);
+#endif
+    m_fid = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, fapl);
+    H5Pclose(fapl);
+    if (m_fid < 0) {
+        amrex::FileOpenFailed(filename);
+    }
+
+    ReadHDF5Attr(m_fid, "num_components", H5T_NATIVE_INT, &m_ncomp);
+    m_var_names.resize(m_ncomp);
+    char comp_name[32];
+    for (int i = 0; i < m_ncomp; ++i) {
+        std::snprintf(comp_name, sizeof(comp_name), "component_%d", i);
+        m_var_names[i] = ReadHDF5AttrString(m_fid, comp_name);
+    }
+
+    double t = 0.0;
+    ReadHDF5Attr(m_fid, "dim", H5T_NATIVE_INT, &m_spacedim);
+    ReadHDF5Attr(m_fid, "time", H5T_NATIVE_DOUBLE, &t);
+    ReadHDF5Attr(m_fid, "finest_level", H5T_NATIVE_INT, &m_finest_level);
+    ReadHDF5Attr(m_fid, "coordinate_system", H5T_NATIVE_INT, &m_coordsys);
+    m_time = static_cast<Real>(t);
+    m_nlevels = m_finest_level+1;
+
+    AMREX_ALWAYS_ASSERT(m_spacedim == AMREX_SPACEDIM);
+
+    m_ref_ratio.resize(m_nlevels, 1);
+    m_prob_domain.resize(m_nlevels);
+    m_level_steps.resize(m_nlevels, 0);
+    m_cell_size.resize(m_nlevels, Array<Real,AMREX_SPACEDIM>{{AMREX_D_DECL(1.,1.,1.)}});
+    m_ba.resize(m_nlevels);
+    m_dmap.resize(m_nlevels);
+    m_layout.resize(m_nlevels, AMRICLayout::Nast);
+    m_block_size.resize(m_nlevels, 0);
+    m_seg_size.resize(m_nlevels, 0);
+    m_seg_begin.resize(m_nlevels);
+    m_seg_bigx.resize(m_nlevels);
+    m_seg_loaded.resize(m_nlevels);
+    m_data.resize(m_nlevels);
+    m_mask.resize(m_nlevels);
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    hid_t box_id = MakeBoxType();
+    char level_name[32];
+    for (int ilev = 0; ilev < m_nlevels; ++ilev) {
+        std::snprintf(level_name, sizeof(level_name), "level_%d", ilev);
+        hid_t grp = H5Gopen(m_fid, level_name, H5P_DEFAULT);
+        if (grp < 0) {
+            amrex::Abort("PlotFileDataHDF5: cannot open "+std::string(level_name)+" in "+filename);
+        }
+
+        ReadHDF5Attr(grp, "ref_ratio", H5T_NATIVE_INT, &m_ref_ratio[ilev]);
+        ReadHDF5Attr(grp, "steps", H5T_NATIVE_INT, &m_level_steps[ilev]);
+
+        double dx[AMREX_SPACEDIM];
+        ReadHDF5Attr(grp, "Vec_dx", H5T_NATIVE_DOUBLE, dx);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            m_cell_size[ilev][idim] = static_cast<Real>(dx[idim]);
+        }
+
+        if (ilev == 0) {
+            double lo[AMREX_SPACEDIM], hi[AMREX_SPACEDIM];
+            ReadHDF5Attr(grp, "prob_lo", H5T_NATIVE_DOUBLE, lo);
+            ReadHDF5Attr(grp, "prob_hi", H5T_NATIVE_DOUBLE, hi);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_prob_lo[idim] = static_cast<Real>(lo[idim]);
+                m_prob_hi[idim] = static_cast<Real>(hi[idim]);
+                m_prob_size[idim] = m_prob_hi[idim] - m_prob_lo[idim];
+            }
+        }
+
+        int domain[2*AMREX_SPACEDIM];
+        ReadHDF5Attr(grp, "prob_domain", box_id, domain);
+        m_prob_domain[ilev] = Box(IntVect(domain), IntVect(domain+AMREX_SPACEDIM));
+
+        // The boxes are stored sorted by the rank that wrote them.
+        Vector<int> vbox = ReadHDF5DsetInt(grp, "boxes", box_id, 2*AMREX_SPACEDIM);
+        const int nboxes = static_cast<int>(vbox.size()) / (2*AMREX_SPACEDIM);
+        BoxList bl;
+        for (int b = 0; b < nboxes; ++b) {
+            int const* p = vbox.data() + b*2*AMREX_SPACEDIM;
+            bl.push_back(Box(IntVect(p), IntVect(p+AMREX_SPACEDIM)));
+        }
+        m_ba[ilev] = BoxArray(std::move(bl));
+
+        int layout = -1;
+        unsigned long long seg_size = 0;
+        if (!ReadHDF5Attr(grp, "amric_layout", H5T_NATIVE_INT, &layout)) {
+            amrex::Abort("PlotFileDataHDF5: "+filename+" has no compressed data layout");
+        }
+        ReadHDF5Attr(grp, "amric_block_size", H5T_NATIVE_INT, &m_block_size[ilev]);
+        ReadHDF5Attr(grp, "amric_seg_size", H5T_NATIVE_ULLONG, &seg_size);
+        m_layout[ilev] = static_cast<AMRICLayout>(layout);
+        m_seg_size[ilev] = static_cast<Long>(seg_size);
+
+        Vector<int> procs = ReadHDF5DsetInt(grp, "amric_procs", H5T_NATIVE_INT, 1);
+        Vector<int> bigx;
+        if (m_layout[ilev] == AMRICLayout::Stack) {
+            bigx = ReadHDF5DsetInt(grp, "amric_bigx", H5T_NATIVE_INT, 1);
+        }
+        AMREX_ALWAYS_ASSERT(static_cast<int>(procs.size()) == nboxes);
+
+        // Boxes written by the same rank form a segment.  The writer lays
+        // out the segments in the order of ranks, which is the order of boxes.
+        Vector<int> pmap(nboxes);
+        for (int b = 0; b < nboxes; ++b) {
+            if (b == 0 || procs[b] != procs[b-1]) {
+                m_seg_begin[ilev].push_back(b);
+                m_seg_bigx[ilev].push_back(bigx.empty() ? 0 : bigx[procs[b]]);
+            }
+            pmap[b] = static_cast<int>(m_seg_begin[ilev].size()-1) % nprocs;
+        }
+        m_seg_loaded[ilev].resize(m_seg_begin[ilev].size(), 0);
+        m_seg_begin[ilev].push_back(nboxes);
+        m_dmap[ilev].define(std::move(pmap));
+
+        H5Gclose(grp);
+    }
+    H5Tclose(box_id);
+
+    refineTo(std::min(preview_level, m_finest_level));
+}
+
+PlotFileDataHDF5::~PlotFileDataHDF5 ()
+{
+    if (m_fid >= 0) {
+        H5Fclose(m_fid);
+    }
+}
+
+int
+PlotFileDataHDF5::loadedLevel () const noexcept
+{
+    int r = -1;
+    for (int ilev = 0; ilev < m_nlevels; ++ilev) {
+        auto const& loaded = m_seg_loaded[ilev];
+        if (std::all_of(loaded.begin(), loaded.end(), [] (char c) { return c != 0; })) {
+            r = ilev;
+        } else {
+            break;
+        }
+    }
+    return r;
+}
+
+void
+PlotFileDataHDF5::refine ()
+{
+    refineTo(std::min(loadedLevel()+1, m_finest_level));
+}
+
+void
+PlotFileDataHDF5::refineTo (int level)
+{
+    if (level >= 0) {
+        refine(level, m_prob_domain[level]);
+    }
+}
+
+void
+PlotFileDataHDF5::refine (int level, Box const& region)
+{
+    BL_PROFILE("PlotFileDataHDF5::refine");
+
+    AMREX_ALWAYS_ASSERT(level >= 0 && level <= m_finest_level);
+
+    if (level > 0) {
+        refine(level-1, amrex::coarsen(region, m_ref_ratio[level-1]));
+    }
+
+    Vector<int> segs;
+    const int nsegs = static_cast<int>(m_seg_loaded[level].size());
+    for (int iseg = 0; iseg < nsegs; ++iseg) {
+        if (m_seg_loaded[level][iseg]) { continue; }
+        for (int b = m_seg_begin[level][iseg]; b < m_seg_begin[level][iseg+1]; ++b) {
+            if (m_ba[level][b].intersects(region)) {
+                segs.push_back(iseg);
+                break;
+            }
+        }
+    }
+
+    if (segs.empty() && m_data[level]) { return; }
+
+    decodeSegments(level, segs);
+    fillFromCoarse(level);
+    for (int ilev = level; ilev > 0; --ilev) {
+        averageDown(ilev);
+    }
+}
+
+const MultiFab&
+PlotFileDataHDF5::get (int level)
+{
+    if (!m_data[level]) {
+        refine(level, m_prob_domain[level]);
+    }
+    return *m_data[level];
+}
+
+MultiFab
+PlotFileDataHDF5::get (int level, std::string const& varname)
+{
+    auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
+    if (r == std::end(m_var_names)) {
+        amrex::Abort("PlotFileDataHDF5::get: varname not found "+varname);
+    }
+    int icomp = static_cast<int>(std::distance(std::begin(m_var_names), r));
+    MultiFab const& src = get(level);
+    MultiFab mf(m_ba[level], m_dmap[level], 1, 0);
+    MultiFab::Copy(mf, src, icomp, 0, 1, 0);
+    return mf;
+}
+
+const iMultiFab&
+PlotFileDataHDF5::decodedMask (int level)
+{
+    if (!m_mask[level]) {
+        refine(level, m_prob_domain[level]);
+    }
+    return *m_mask[level];
+}
+
+void
+PlotFileDataHDF5::allocateLevel (int level)
+{
+    if (!m_data[level]) {
+        m_data[level] = std::make_unique<MultiFab>(m_ba[level], m_dmap[level], m_ncomp, 0);
+        m_data[level]->setVal(0.0);
+        m_mask[level] = std::make_unique<iMultiFab>(m_ba[level], m_dmap[level], 1, 0);
+        m_mask[level]->setVal(0);
+    }
+}
+
+void
+PlotFileDataHDF5::decodeSegments (int level, Vector<int> const& segs)
+{
+    allocateLevel(level);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "level_%d", level);
+    hid_t grp = H5Gopen(m_fid, name, H5P_DEFAULT);
+
+    const AMRICLayout layout = m_layout[level];
+    const int ndsets = (layout == AMRICLayout::Stack) ? 1 : m_ncomp;
+    Vector<hid_t> dsets(ndsets);
+    for (int n = 0; n < ndsets; ++n) {
+        std::snprintf(name, sizeof(name), "data:datatype=%d", n);
+        dsets[n] = H5Dopen(grp, name, H5P_DEFAULT);
+    }
+
+    // Cells covered by the next finer level were not written.
+    BoxArray baf;
+    if (level < m_finest_level) {
+        baf = amrex::coarsen(m_ba[level+1], m_ref_ratio[level]);
+    }
+
+    const Long seg_size = m_seg_size[level];
+    const int bs = m_block_size[level];
+    const int myproc = ParallelDescriptor::MyProc();
+    Vector<double> buf(seg_size);
+    hsize_t count = seg_size;
+    hid_t memspace = H5Screate_simple(1, &count, NULL);
+
+    for (int iseg : segs) {
+        m_seg_loaded[level][iseg] = 1;
+        const int bbegin = m_seg_begin[level][iseg];
+        const int bend = m_seg_begin[level][iseg+1];
+        if (m_dmap[level][bbegin] != myproc) { continue; }
+
+        const Long bigx = m_seg_bigx[level][iseg];
+        for (int n = 0; n < m_ncomp; ++n) {
+            hid_t dset = dsets[(layout == AMRICLayout::Stack) ? 0 : n];
+            hsize_t offset = (layout == AMRICLayout::Stack)
+                ? (iseg*m_ncomp + n) * seg_size : iseg * seg_size;
+            hid_t filespace = H5Dget_space(dset);
+            H5Sselect_hyperslab(filespace, H5S_SELECT_SET, &offset, NULL, &count, NULL);
+            herr_t ret = H5Dread(dset, H5T_NATIVE_DOUBLE, memspace, filespace, H5P_DEFAULT, buf.data());
+            H5Sclose(filespace);
+            if (ret < 0) {
+                amrex::Abort("PlotFileDataHDF5: failed to read "+m_plotfile_name);
+            }
+
+            Long cnt = 0;
+            for (int b = bbegin; b < bend; ++b) {
+                const Box& box = m_ba[level][b];
+                IArrayBox covered(box, 1);
+                covered.setVal<RunOn::Host>(0);
+                if (!baf.empty()) {
+                    for (auto const& is : baf.intersections(box)) {
+                        covered.setVal<RunOn::Host>(1, is.second);
+                    }
+                }
+                auto const& cov = covered.const_array();
+                auto const& dst = (*m_data[level])[b].array();
+                auto const& msk = (*m_mask[level])[b].array();
+
+                // Same traversal as the writer: bs^3 blocks of the box, and
+                // the uncovered cells of each block in Fortran order.
+                const Dim3 lo = amrex::lbound(box);
+                const Dim3 hi = amrex::ubound(box);
+                for (int z = 0; z < (hi.z-lo.z+1)/bs; ++z) {
+                for (int y = 0; y < (hi.y-lo.y+1)/bs; ++y) {
+                for (int x = 0; x < (hi.x-lo.x+1)/bs; ++x) {
+                    for (int k = lo.z+z*bs; k < lo.z+z*bs+bs; ++k) {
+                    for (int j = lo.y+y*bs; j < lo.y+y*bs+bs; ++j) {
+                    for (int i = lo.x+x*bs; i < lo.x+x*bs+bs; ++i) {
+                        if (cov(i,j,k) == 0) {
+                            dst(i,j,k,n) = static_cast<Real>(buf[AMRICIndex(layout, cnt, bs, bigx)]);
+                            msk(i,j,k) = 1;
+                            ++cnt;
+                        }
+                    }}}
+                }}}
+            }
+        }
+    }
+
+    H5Sclose(memspace);
+    for (auto dset : dsets) {
+        H5Dclose(dset);
+    }
+    H5Gclose(grp);
+}
+
+void
+PlotFileDataHDF5::fillFromCoarse (int level)
+{
+    if (level == 0) { return; }
+
+    const IntVect rr(m_ref_ratio[level-1]);
+    MultiFab crse(amrex::coarsen(m_ba[level], rr), m_dmap[level], m_ncomp, 0);
+    crse.ParallelCopy(*m_data[level-1]);
+
+    for (MFIter mfi(*m_data[level]); mfi.isValid(); ++mfi) {
+        auto const& fine = m_data[level]->array(mfi);
+        auto const& msk = m_mask[level]->const_array(mfi);
+        auto const& c = crse.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), m_ncomp, [&] (int i, int j, int k, int n)
+        {
+            if (msk(i,j,k) == 0) {
+                IntVect iv(AMREX_D_DECL(i,j,k));
+                fine(i,j,k,n) = c(amrex::coarsen(iv,rr),n);
+            }
+        });
+    }
+}
+
+void
+PlotFileDataHDF5::averageDown (int level)
+{
+    const IntVect rr(m_ref_ratio[level-1]);
+    const Real volinv = Real(1.0) / static_cast<Real>(AMREX_D_TERM(rr[0],*rr[1],*rr[2]));
+    const BoxArray cba = amrex::coarsen(m_ba[level], rr);
+    MultiFab cval(cba, m_dmap[level], m_ncomp, 0);
+    iMultiFab cflag(cba, m_dmap[level], 1, 0);
+
+    // A coarse cell gets a value only if all of its children are known.
+    for (MFIter mfi(cval); mfi.isValid(); ++mfi) {
+        auto const& fine = m_data[level]->const_array(mfi);
+        auto const& fmsk = m_mask[level]->const_array(mfi);
+        auto const& cv = cval.array(mfi);
+        auto const& cf = cflag.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+        {
+            IntVect civ(AMREX_D_DECL(i,j,k));
+            Box children = amrex::refine(Box(civ,civ), rr);
+            bool known = true;
+            amrex::LoopOnCpu(children, [&] (int ii, int jj, int kk)
+            {
+                known = known && (fmsk(ii,jj,kk) != 0);
+            });
+            cf(i,j,k) = known ? 1 : 0;
+            for (int n = 0; n < m_ncomp; ++n) {
+                Real s = 0.0;
+                if (known) {
+                    amrex::LoopOnCpu(children, [&] (int ii, int jj, int kk)
+                    {
+                        s += fine(ii,jj,kk,n);
+                    });
+                }
+                cv(i,j,k,n) = s*volinv;
+            }
+        });
+    }
+
+    MultiFab crse(m_ba[level-1], m_dmap[level-1], m_ncomp, 0);
+    iMultiFab crse_flag(m_ba[level-1], m_dmap[level-1], 1, 0);
+    crse_flag.setVal(0);
+    crse.ParallelCopy(cval);
+    crse_flag.ParallelCopy(cflag);
+
+    for (MFIter mfi(*m_data[level-1]); mfi.isValid(); ++mfi) {
+        auto const& dst = m_data[level-1]->array(mfi);
+        auto const& msk = m_mask[level-1]->array(mfi);
+        auto const& src = crse.const_array(mfi);
+        auto const& flg = crse_flag.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+        {
+            if (msk(i,j,k) != 1 && flg(i,j,k) == 1) {
+                for (int n = 0; n < m_ncomp; ++n) {
+                    dst(i,j,k,n) = src(i,j,k,n);
+                }
+                msk(i,j,k) = 2;
+            }
+        });
+    }
+}
+
+}
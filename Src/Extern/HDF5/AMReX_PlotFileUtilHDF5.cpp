@@ -3,6 +3,8 @@
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_ParmParse.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -26,6 +28,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <numeric>
 
 #define BSIZE 8
@@ -123,6 +126,116 @@ static int CreateWriteHDF5AttrString(hid_t loc, const char *name, const char* st
     return 1;
 }
 
+// Record how the uncovered cells of a level were packed into the data
+// datasets, so that readers (e.g., PlotFileDataHDF5) do not need the meta/
+// text files.  seg_size is the length of one component of one rank's segment
+// (i.e., the chunk size).  Must be called by all ranks; only the IO rank
+// writes data.
+static void WriteAMRICLayoutHDF5(hid_t grp, AMRICLayout layout, int block_size,
+                                 unsigned long long seg_size,
+                                 const Vector<int>& sortedProcs,
+                                 const Vector<int>& bigx, hid_t dxpl)
+{
+    int ilayout = static_cast<int>(layout);
+    CreateWriteHDF5AttrInt(grp, "amric_layout", 1, &ilayout);
+    CreateWriteHDF5AttrInt(grp, "amric_block_size", 1, &block_size);
+
+    hsize_t one = 1;
+    hid_t space = H5Screate_simple(1, &one, NULL);
+    hid_t attr = H5Acreate(grp, "amric_seg_size", H5T_NATIVE_ULLONG, space, H5P_DEFAULT, H5P_DEFAULT);
+    H5Awrite(attr, H5T_NATIVE_ULLONG, &seg_size);
+    H5Aclose(attr);
+    H5Sclose(space);
+
+    hsize_t nprocs = sortedProcs.size();
+    space = H5Screate_simple(1, &nprocs, NULL);
+    hid_t dset = H5Dcreate(grp, "amric_procs", H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (ParallelDescriptor::IOProcessor() && nprocs > 0) {
+        H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, sortedProcs.data());
+    }
+    H5Dclose(dset);
+    H5Sclose(space);
+
+    if (layout == AMRICLayout::Stack) {
+        hsize_t nbigx = ParallelDescriptor::NProcs();
+        space = H5Screate_simple(1, &nbigx, NULL);
+        dset = H5Dcreate(grp, "amric_bigx", H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        if (ParallelDescriptor::IOProcessor()) {
+            H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, bigx.data());
+        }
+        H5Dclose(dset);
+        H5Sclose(space);
+    }
+}
+
+// Number of cells of each box of ba not covered by baf, the coarsened boxes
+// of the next finer level.  These are the cells the compressed writers pack.
+static Vector<Real> UncoveredCellsHDF5 (const BoxArray& ba, const BoxArray& baf)
+{
+    Vector<Real> ncells(ba.size());
+    std::vector<std::pair<int,Box> > isects;
+    for (int i = 0, N = static_cast<int>(ba.size()); i < N; ++i) {
+        const Box& bx = ba[i];
+        Long n = bx.numPts();
+        if (!baf.empty()) {
+            baf.intersections(bx, isects);
+            for (auto const& is : isects) {
+                n -= is.second.numPts();
+            }
+        }
+        ncells[i] = static_cast<Real>(n);
+    }
+    return ncells;
+}
+
+static Real MaxRankCellsHDF5 (const Vector<Real>& ncells, const DistributionMapping& dm)
+{
+    Vector<Real> rank_cells(ParallelDescriptor::NProcs(), 0.0_rt);
+    for (int i = 0, N = static_cast<int>(ncells.size()); i < N; ++i) {
+        rank_cells[dm[i]] += ncells[i];
+    }
+    return *std::max_element(rank_cells.begin(), rank_cells.end());
+}
+
+static int amric_remap = -1;  // hdf5.amric_remap, read on first use
+
+// With hdf5.amric_remap=1, the compressed writers balance the uncovered
+// cells of each level before packing them.  Each rank's segment is padded
+// to the largest one, so the most loaded rank sets the size of the file and
+// the time to compress and write it.  Returns a copy of mf distributed by
+// knapsack on the uncovered cells, or nullptr if remapping is off or would
+// not lower the largest segment.
+
+static std::unique_ptr<MultiFab>
+AMRICRemapHDF5 (const MultiFab& mf, const Vector<Real>& ncells, int level)
+{
+    if (amric_remap < 0) {
+        amric_remap = 0;
+        ParmParse pp("hdf5");
+        pp.queryAdd("amric_remap", amric_remap);
+        ExecOnFinalize([] () { amric_remap = -1; });
+    }
+    if (!amric_remap || ParallelDescriptor::NProcs() == 1) { return nullptr; }
+
+    BL_PROFILE("AMRICRemapHDF5");
+
+    const Real oldmax = MaxRankCellsHDF5(ncells, mf.DistributionMap());
+    DistributionMapping dm = DistributionMapping::makeKnapSack(ncells);
+    const Real newmax = MaxRankCellsHDF5(ncells, dm);
+
+    if (amrex::Verbose()) {
+        amrex::Print() << "AMRIC remap level " << level << ": largest segment "
+                       << static_cast<Long>(oldmax) << " -> " << static_cast<Long>(newmax)
+                       << " uncovered cells\n";
+    }
+
+    if (newmax >= oldmax) { return nullptr; }
+
+    auto r = std::make_unique<MultiFab>(mf.boxArray(), dm, mf.nComp(), 0);
+    r->ParallelCopy(mf, 0, 0, mf.nComp());
+    return r;
+}
+
 #ifdef BL_USE_MPI
 static void SetHDF5fapl(hid_t fapl, MPI_Comm comm)
 #else
@@ -551,9 +664,18 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
 #endif
         if (grp < 0) { std::cout << "H5Gopen [" << level_name << "] failed!" << std::endl; break; }
 
+        // Only the cells not covered by the next finer level are written.
+        BoxArray baf;
+        if (level < finest_level) {
+            baf = amrex::coarsen(mf[level+1]->boxArray(), ref_ratio[level]);
+        }
+        const Vector<Real> ncells = UncoveredCellsHDF5(mf[level]->boxArray(), baf);
+        std::unique_ptr<MultiFab> remapped = AMRICRemapHDF5(*mf[level], ncells, level);
+        const MultiFab& lmf = remapped ? *remapped : *mf[level];
+
         // Get the boxes assigned to all ranks and calculate their offsets and sizes
-        Vector<int> procMap = mf[level]->DistributionMap().ProcessorMap();
-        const BoxArray& grids = mf[level]->boxArray();
+        Vector<int> procMap = lmf.DistributionMap().ProcessorMap();
+        const BoxArray& grids = lmf.boxArray();
         hid_t boxdataset, boxdataspace;
         hid_t offsetdataset, offsetdataspace;
         hid_t centerdataset, centerdataspace;
@@ -681,6 +803,33 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
             /* } */
         }
 
+        int bbb=16;
+        std::ifstream bFile("bbb.txt");
+        if (bFile.is_open()) {
+            bFile >> bbb;
+            bFile.close();
+        } else {
+            std::cerr << "Unable to open the bbb file." << std::endl;
+        }
+        int bSize =  bbb*std::pow(2,(double)level);
+
+        //std::cout << "bSize: " << bSize << std::endl;
+
+        size_t unitBlkSize = bSize*bSize*bSize;
+        if (remapped) {
+            // The segments only need to hold whole bricks of uncovered cells.
+            for (auto it = gridMap.begin(); it != gridMap.end(); ++it) {
+                realProcBufferSize[it->first] = 0;
+            }
+            for (int i(0); i < grids.size(); ++i) {
+                realProcBufferSize[procMap[i]] += static_cast<unsigned long long>(ncells[i]);
+            }
+            for (auto it = gridMap.begin(); it != gridMap.end(); ++it) {
+                auto& n = realProcBufferSize[it->first];
+                n = std::max<unsigned long long>((n + unitBlkSize - 1) / unitBlkSize, 1) * unitBlkSize;
+            }
+        }
+
         //dcdc find maxBuf
         unsigned long long maxBuf = *max_element(realProcBufferSize.begin(), realProcBufferSize.end());
         if(ParallelDescriptor::IOProcessor())
@@ -805,46 +954,34 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
 
         //dcdc-start
         auto preFileTime0 = amrex::second();
-        MultiFab *tempmf = const_cast<MultiFab*>(mf[level]);
-        Real bogus_flag=-1e200;
+        // Covered cells are marked in a mask, so that the data are read
+        // as they are, without a flagged copy.
+        const MultiFab* tempmf = &lmf;
+        iMultiFab covered;
         if (level < finest_level)
         {
-            MultiFab *highMf = const_cast<MultiFab*>(mf[level+1]);
-            const BoxArray baf = BoxArray((*highMf).boxArray()).coarsen(ref_ratio[level]);
-            for (MFIter mfi(*tempmf); mfi.isValid(); ++mfi)
+            covered.define(lmf.boxArray(), lmf.DistributionMap(), 1, 0);
+            covered.setVal(0);
+            std::vector< std::pair<int,Box> > isects;
+            for (MFIter mfi(covered); mfi.isValid(); ++mfi)
             {
-                FArrayBox& myFab = (*tempmf)[mfi];
-                    std::vector< std::pair<int,Box> > isects = baf.intersections((*tempmf).boxArray()[mfi.index()]);
-
-
-                for (int ii = 0; ii < isects.size(); ii++){
-                    myFab.setVal(bogus_flag,isects[ii].second,0,ncomp);
+                IArrayBox& mask = covered[mfi];
+                baf.intersections(covered.boxArray()[mfi.index()], isects);
+                for (auto const& is : isects) {
+                    mask.setVal(1, is.second);
                 }
             }
         }
 
 
-        int bbb=16;
-        std::ifstream bFile("bbb.txt");
-        if (bFile.is_open()) {
-            bFile >> bbb;
-            bFile.close();
-        } else {
-            std::cerr << "Unable to open the bbb file." << std::endl;
-        }
-        int bSize =  bbb*std::pow(2,(double)level);
-
-        //std::cout << "bSize: " << bSize << std::endl;
-
         Vector<Real> b_buffer(procBufferSize[myProc], 0);
         long long cnt = 0;
         long long tempCnt = 0;
         size_t bigX=1;
 
         // /*stack*/
-         size_t unitBlkSize = bSize*bSize*bSize;
          if (realProcBufferSize[myProc]>0){
-         bigX = cbrt(realProcBufferSize[myProc]/(unitBlkSize));
+         bigX = std::max<size_t>(1, cbrt(realProcBufferSize[myProc]/(unitBlkSize)));
          //std::cout<< "init bigX: " << bigX << std::endl;
              size_t testBigZ = ((realProcBufferSize[myProc]/unitBlkSize) + (bigX*bigX) - 1) / (bigX*bigX);
              //std::cout<< "testBigZ: " << testBigZ << std::endl;
@@ -859,11 +996,22 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
          size_t b2Size = bSize*bSize;
          size_t big2X = bigX*bigX;
 
+        {
+            int mybigx = static_cast<int>(bigX);
+            Vector<int> allbigx(nProcs, 0);
+            ParallelDescriptor::Gather(&mybigx, 1, allbigx.data(), 1,
+                                       ParallelDescriptor::IOProcessorNumber());
+            WriteAMRICLayoutHDF5(grp, AMRICLayout::Stack, bSize, maxBuf,
+                                 sortedProcs, allbigx, dxpl_ind);
+        }
+
 
         for (int pp = 0; pp < ncomp; pp++) {
             for (MFIter mfi(*tempmf); mfi.isValid(); ++mfi)
             {
-                Array4<Real> const& fab_array = (*tempmf).array(mfi);
+                Array4<Real const> const& fab_array = (*tempmf).const_array(mfi);
+                Array4<int const> const& cov = covered.ok() ? covered.const_array(mfi)
+                                                            : Array4<int const>{};
                 int ncomp = (*tempmf).nComp();
                 const Box& box = mfi.validbox();
 
@@ -888,7 +1036,7 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
                              for (int k = lo.z+z*bSize; k < lo.z+z*bSize+bSize; ++k){
                                  for (int j =lo.y+y*bSize; j <lo.y+y*bSize+bSize; ++j){
                                      for (int i = lo.x+x*bSize; i <lo.x+x*bSize+bSize; ++i){
-                                         if(fab_array(i,j,k,0) != bogus_flag) {
+                                         if(!cov || cov(i,j,k) == 0) {
                                              cc = tempCnt/(unitBlkSize);
                                              zz = cc/big2X;
                                              yy = (cc - zz*big2X)/bigX;
@@ -919,7 +1067,7 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
                                 for (int k = lo.z+z*bSize; k < lo.z+z*bSize+bSize; ++k)
                                     for (int j =lo.y+y*bSize; j <lo.y+y*bSize+bSize; ++j)
                                         for (int i = lo.x+x*bSize; i <lo.x+x*bSize+bSize; ++i){
-                                            if(fab_array(i,j,k,0) != bogus_flag) {
+                                            if(!cov || cov(i,j,k) == 0) {
                                                 b_buffer[tempCnt + pp*maxBuf] = fab_array(i,j,k,pp);
                                                 tempCnt++;
                                             }
@@ -934,7 +1082,7 @@ void WriteMultiLevelPlotfileHDF5SingleDset (const std::string& plotfilename,
                 // for (int z = lo.z; z <= hi.z; ++z)
                 //     for (int y = lo.y; y <= hi.y; ++y)
                 //         for (int x = lo.x; x <= hi.x; ++x) {
-                //             if(fab_array(x,y,z,0) != bogus_flag) {
+                //             if(!cov || cov(x,y,z) == 0) {
                 //                 b_buffer[cnt] = fab_array(x,y,z,0);
                 //                 cnt++;
                 //             }
@@ -1355,9 +1503,18 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
 #endif
         if (grp < 0) { std::cout << "H5Gopen [" << level_name << "] failed!" << std::endl; break; }
 
+        // Only the cells not covered by the next finer level are written.
+        BoxArray baf;
+        if (level < finest_level) {
+            baf = amrex::coarsen(mf[level+1]->boxArray(), ref_ratio[level]);
+        }
+        const Vector<Real> ncells = UncoveredCellsHDF5(mf[level]->boxArray(), baf);
+        std::unique_ptr<MultiFab> remapped = AMRICRemapHDF5(*mf[level], ncells, level);
+        const MultiFab& lmf = remapped ? *remapped : *mf[level];
+
         // Get the boxes assigned to all ranks and calculate their offsets and sizes
-        Vector<int> procMap = mf[level]->DistributionMap().ProcessorMap();
-        const BoxArray& grids = mf[level]->boxArray();
+        Vector<int> procMap = lmf.DistributionMap().ProcessorMap();
+        const BoxArray& grids = lmf.boxArray();
         hid_t boxdataset, boxdataspace;
         hid_t offsetdataset, offsetdataspace;
         hid_t centerdataset, centerdataspace;
@@ -1437,6 +1594,20 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
                 realProcBufferSize[proc] += boxesAtProc[b].numPts();
             }
         }
+        if (remapped) {
+            // The segments only need to hold the uncovered cells.
+            for (auto it = gridMap.begin(); it != gridMap.end(); ++it) {
+                realProcBufferSize[it->first] = 0;
+            }
+            for (int i(0); i < grids.size(); ++i) {
+                realProcBufferSize[procMap[i]] += static_cast<unsigned long long>(ncells[i]);
+            }
+            // Keep a segment for each rank with boxes, as readers expect.
+            for (auto it = gridMap.begin(); it != gridMap.end(); ++it) {
+                auto& n = realProcBufferSize[it->first];
+                n = std::max<unsigned long long>(n, 1);
+            }
+        }
 
 
 
@@ -1534,26 +1705,30 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
 
         BL_PROFILE_VAR("H5DwriteData", h5dwg);
         //dcdc-start
-        MultiFab *tempmf = const_cast<MultiFab*>(mf[level]);
-        Real bogus_flag=-1e200;
+        // Covered cells are marked in a mask, so that the data are read
+        // as they are, without a flagged copy.
+        const MultiFab* tempmf = &lmf;
+        iMultiFab covered;
         if (level < finest_level)
         {
-            MultiFab *highMf = const_cast<MultiFab*>(mf[level+1]);
-            const BoxArray baf = BoxArray((*highMf).boxArray()).coarsen(ref_ratio[level]);
-            for (MFIter mfi(*tempmf); mfi.isValid(); ++mfi)
+            covered.define(lmf.boxArray(), lmf.DistributionMap(), 1, 0);
+            covered.setVal(0);
+            std::vector< std::pair<int,Box> > isects;
+            for (MFIter mfi(covered); mfi.isValid(); ++mfi)
             {
-                FArrayBox& myFab = (*tempmf)[mfi];
-                    std::vector< std::pair<int,Box> > isects = baf.intersections((*tempmf).boxArray()[mfi.index()]);
-
-
-                for (int ii = 0; ii < isects.size(); ii++){
-                    myFab.setVal(bogus_flag,isects[ii].second,0,ncomp);
+                IArrayBox& mask = covered[mfi];
+                baf.intersections(covered.boxArray()[mfi.index()], isects);
+                for (auto const& is : isects) {
+                    mask.setVal(1, is.second);
                 }
             }
         }
 
         int bSize = BSIZE;
 
+        WriteAMRICLayoutHDF5(grp, AMRICLayout::Nast, bSize, maxBuf,
+                             sortedProcs, Vector<int>(), dxpl_ind);
+
         size_t bigX=0;
         // /*stack*/
         // size_t unitBlkSize = bSize*bSize*bSize;
@@ -1573,7 +1748,9 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
             long long cnt = 0;
             for (MFIter mfi(*tempmf); mfi.isValid(); ++mfi)
             {
-                Array4<Real> const& fab_array = (*tempmf).array(mfi);
+                Array4<Real const> const& fab_array = (*tempmf).const_array(mfi);
+                Array4<int const> const& cov = covered.ok() ? covered.const_array(mfi)
+                                                            : Array4<int const>{};
                 int ncomp = (*tempmf).nComp();
                 const Box& box = mfi.validbox();
 
@@ -1599,7 +1776,7 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
                 //             for (int k = lo.z+z*bSize; k < lo.z+z*bSize+bSize; ++k){
                 //                 for (int j =lo.y+y*bSize; j <lo.y+y*bSize+bSize; ++j){
                 //                     for (int i = lo.x+x*bSize; i <lo.x+x*bSize+bSize; ++i){
-                //                         if(fab_array(i,j,k,0) != bogus_flag) {
+                //                         if(!cov || cov(i,j,k) == 0) {
                 //                             cc = cnt/(unitBlkSize);
                 //                             zz = cc/big2X;
                 //                             yy = (cc - zz*big2X)/bigX;
@@ -1630,7 +1807,7 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
                             for (int k = lo.z+z*bSize; k < lo.z+z*bSize+bSize; ++k)
                                 for (int j =lo.y+y*bSize; j <lo.y+y*bSize+bSize; ++j)
                                     for (int i = lo.x+x*bSize; i <lo.x+x*bSize+bSize; ++i){
-                                        if(fab_array(i,j,k,0) != bogus_flag) {
+                                        if(!cov || cov(i,j,k) == 0) {
                                             b_buffer[cnt] = fab_array(i,j,k,jj);
                                             cnt++;
                                         }
@@ -1646,7 +1823,7 @@ void WriteMultiLevelPlotfileHDF5MultiDset (const std::string& plotfilename,
                 // for (int z = lo.z; z <= hi.z; ++z)
                 //     for (int y = lo.y; y <= hi.y; ++y)
                 //         for (int x = lo.x; x <= hi.x; ++x) {
-                //             if(fab_array(x,y,z,0) != bogus_flag) {
+                //             if(!cov || cov(x,y,z) == 0) {
                 //                 b_buffer[cnt] = fab_array(x,y,z,jj);
                 //                 cnt++;
                 //             }
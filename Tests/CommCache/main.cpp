@@ -0,0 +1,139 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+// Evict FillBoundary and ParallelCopy metadata under a tiny cache budget
+// while the ranks hold very different amounts of it.  All ranks have to
+// evict the same entries, or persistent requests and neighborhood
+// collectives stop matching across ranks.
+
+namespace {
+
+Real value (IntVect const& iv, Box const& domain)
+{
+    Real r = 0;
+    Real s = 1;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        int n = domain.length(d);
+        int i = ((iv[d] - domain.smallEnd(d)) % n + n) % n;
+        r += s * Real(i);
+        s *= Real(1000);
+    }
+    return r;
+}
+
+void fill (MultiFab& mf, Box const& domain)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        FArrayBox& fab = mf[mfi];
+        fab.setVal<RunOn::Host>(-1);
+        const Box& bx = mfi.validbox();
+        for (BoxIterator bi(bx); bi.ok(); ++bi) {
+            fab(bi()) = value(bi(), domain);
+        }
+    }
+}
+
+int check (MultiFab const& mf, Box const& domain, bool grown)
+{
+    int nbad = 0;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const FArrayBox& fab = mf[mfi];
+        const Box bx = grown ? mfi.fabbox() : mfi.validbox();
+        for (BoxIterator bi(bx); bi.ok(); ++bi) {
+            if (fab(bi()) != value(bi(), domain)) { ++nbad; }
+        }
+    }
+    ParallelDescriptor::ReduceIntSum(nbad);
+    return nbad;
+}
+
+// Most boxes go to rank 0, so its caches hold far more bytes.
+DistributionMapping lopsided (BoxArray const& ba)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    Vector<int> pmap(ba.size());
+    for (int i = 0; i < ba.size(); ++i) {
+        pmap[i] = (nprocs == 1 || i % 4 != 0) ? 0 : 1 + i % (nprocs-1);
+    }
+    return DistributionMapping(std::move(pmap));
+}
+
+int run (char const* name)
+{
+    const Box domain(IntVect(0), IntVect(31));
+    const Geometry geom(domain, RealBox(AMREX_D_DECL(0.,0.,0.),AMREX_D_DECL(1.,1.,1.)),
+                        0, Array<int,AMREX_SPACEDIM>{AMREX_D_DECL(1,1,1)});
+
+    const int nmf = 8;
+    Vector<MultiFab> mfs(nmf);
+    for (int n = 0; n < nmf; ++n) {
+        BoxArray ba(domain);
+        ba.maxSize(4 + 2*(n%4));
+        if (n >= 4) { ba.maxSize(IntVect(AMREX_D_DECL(32,8,4))); }
+        mfs[n].define(ba, lopsided(ba), 1, 2);
+    }
+
+    int nbad = 0;
+    Long fb_evict = 0, cpc_evict = 0;
+    for (int iter = 0; iter < 4; ++iter) {
+        if (iter == 1) {
+            // A budget that rank 0 exceeds but the others do not.
+            Long bytes[4] = {FabArrayBase::m_FBC_stats.bytes, -FabArrayBase::m_FBC_stats.bytes,
+                             FabArrayBase::m_CPC_stats.bytes, -FabArrayBase::m_CPC_stats.bytes};
+            ParallelDescriptor::ReduceLongMax(bytes, 4);
+            FabArrayBase::comm_cache_max_bytes = std::min(bytes[0] - bytes[1],
+                                                          bytes[2] - bytes[3]) / 2;
+            FabArrayBase::flushFBCache();
+            FabArrayBase::flushCPCache();
+            fb_evict = FabArrayBase::m_FBC_stats.nevict;
+            cpc_evict = FabArrayBase::m_CPC_stats.nevict;
+        }
+        for (int n = 0; n < nmf; ++n) {
+            fill(mfs[n], domain);
+            mfs[n].FillBoundary(geom.periodicity());
+            nbad += check(mfs[n], domain, true);
+        }
+        for (int n = 0; n < nmf; ++n) {
+            MultiFab& dst = mfs[(n+3)%nmf];
+            dst.setVal(-1);
+            dst.ParallelCopy(mfs[n]);
+            nbad += check(dst, domain, false);
+        }
+    }
+
+    amrex::Print() << name << ": " << (nbad == 0 ? "passed" : "FAILED")
+                   << ", " << FabArrayBase::m_FBC_stats.nevict - fb_evict << " FB and "
+                   << FabArrayBase::m_CPC_stats.nevict - cpc_evict << " CPC evictions\n";
+
+    FabArrayBase::comm_cache_max_bytes = -1;
+    FabArrayBase::flushFBCache();
+    FabArrayBase::flushCPCache();
+    return nbad;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nbad = run("default");
+
+        FabArrayBase::persistent_comm = true;
+        nbad += run("persistent_comm");
+        FabArrayBase::persistent_comm = false;
+
+        FabArrayBase::neighbor_collectives = true;
+        nbad += run("neighbor_collectives");
+        FabArrayBase::neighbor_collectives = false;
+
+        if (nbad != 0) {
+            amrex::Abort("CommCache test failed");
+        }
+    }
+    amrex::Finalize();
+}
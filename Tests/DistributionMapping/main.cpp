@@ -0,0 +1,371 @@
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+
+using namespace amrex;
+
+// Checks of the GRAPH and HILBERT distributions and of the incremental
+// rebalance.
+
+namespace {
+
+Vector<Long> rank_loads (DistributionMapping const& dm, std::vector<Long> const& wgts, int nprocs)
+{
+    Vector<Long> load(nprocs, 0);
+    for (int i = 0; i < dm.size(); ++i) {
+        load[dm[i]] += wgts[i];
+    }
+    return load;
+}
+
+// Every box gets a rank, the ranks agree on the mapping, and no rank is
+// more than graph_imbalance heavier than the average.  On a uniform grid,
+// the off-rank halo is no larger than that of the SFC distribution.
+int graph (std::string const& name, BoxArray const& ba, std::vector<Long> const& wgts,
+           bool uniform)
+{
+    const int nprocs = ParallelContext::NProcsSub();
+    const int N = static_cast<int>(ba.size());
+
+    Real imbalance = Real(0.03);
+    ParmParse pp("DistributionMapping");
+    pp.query("graph_imbalance", imbalance);
+
+    DistributionMapping dm;
+    Real eff = 0;
+    dm.GraphProcessorMap(ba, wgts, nprocs, &eff);
+
+    int nbad = 0;
+    for (int i = 0; i < N; ++i) {
+        if (dm[i] < 0 || dm[i] >= nprocs) { ++nbad; }
+    }
+    if (nbad > 0) {
+        amrex::Print() << name << ": " << nbad << " boxes without a rank, FAILED\n";
+        return nbad;
+    }
+
+    Vector<int> root_pmap = dm.ProcessorMap();
+    ParallelDescriptor::Bcast(root_pmap.data(), root_pmap.size(),
+                              ParallelDescriptor::IOProcessorNumber());
+    int ndiff = (root_pmap == dm.ProcessorMap()) ? 0 : 1;
+    ParallelDescriptor::ReduceIntSum(ndiff);
+    if (ndiff > 0) {
+        amrex::Print() << name << ": mapping differs on " << ndiff << " ranks, FAILED\n";
+        ++nbad;
+    }
+
+    const Vector<Long> load = rank_loads(dm, wgts, nprocs);
+    Long sum_wgt = 0;
+    for (auto w : wgts) { sum_wgt += w; }
+    const Long max_load = *std::max_element(load.begin(), load.end());
+    const Real avg = static_cast<Real>(sum_wgt) / static_cast<Real>(nprocs);
+    if (static_cast<Real>(max_load) > (1+imbalance)*avg
+        || std::abs(eff - avg/static_cast<Real>(max_load)) > Real(1.e-6))
+    {
+        amrex::Print() << name << ": efficiency " << eff << ", max load " << max_load
+                       << ", average " << avg << ", FAILED\n";
+        ++nbad;
+    }
+
+    const Long cut = dm.OffRankHaloCells(ba, IntVect(1));
+    Long sfc_cut = -1;
+    if (uniform) {
+        DistributionMapping sfc;
+        sfc.SFCProcessorMap(ba, wgts, nprocs);
+        sfc_cut = sfc.OffRankHaloCells(ba, IntVect(1));
+        if (cut > sfc_cut) {
+            amrex::Print() << name << ": off-rank halo cells " << cut << " > SFC " << sfc_cut
+                           << ", FAILED\n";
+            ++nbad;
+        }
+    }
+
+    if (nbad == 0) {
+        amrex::Print() << name << ": efficiency " << eff << ", off-rank halo cells " << cut;
+        if (uniform) { amrex::Print() << ", SFC " << sfc_cut; }
+        amrex::Print() << ", passed\n";
+    }
+    return nbad;
+}
+
+int graph_tests ()
+{
+    const Box domain(IntVect(0), IntVect(63));
+    BoxArray ba(domain);
+    ba.maxSize(8);
+    const int N = static_cast<int>(ba.size());
+
+    int nbad = graph("GRAPH uniform", ba, std::vector<Long>(N, ba[0].numPts()), true);
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<Long> dist(1, 10);
+    std::vector<Long> wgts(N);
+    for (auto& w : wgts) { w = dist(gen); }
+    nbad += graph("GRAPH random weights", ba, wgts, false);
+
+    return nbad;
+}
+
+// Order of the boxes along the curve of the current strategy: with as
+// many chains as boxes, each chain is one box.
+std::vector<int> curve_order (BoxArray const& ba)
+{
+    std::vector<int> order;
+    for (auto const& chain : DistributionMapping::makeSFC(ba, false, static_cast<int>(ba.size()))) {
+        order.insert(order.end(), chain.begin(), chain.end());
+    }
+    return order;
+}
+
+// On a grid of 2^k by 2^k boxes, consecutive boxes along the Hilbert
+// curve share a face.
+int hilbert_adjacency (int nside)
+{
+    const int len = 4;
+    const Box domain(IntVect(0), IntVect(nside*len-1));
+    BoxArray ba(domain);
+    ba.maxSize(len);
+
+    const std::vector<int> order = curve_order(ba);
+    int nbad = (static_cast<int>(order.size()) == ba.size()) ? 0 : 1;
+    for (int k = 1; k < static_cast<int>(order.size()) && nbad == 0; ++k) {
+        const Box a = ba[order[k-1]], b = ba[order[k]];
+        const IntVect d = b.smallEnd() - a.smallEnd();
+        int nface = 0, nother = 0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (std::abs(d[idim]) == len) {
+                ++nface;
+            } else if (d[idim] != 0) {
+                ++nother;
+            }
+        }
+        if (nface != 1 || nother != 0) { ++nbad; }
+    }
+
+    amrex::Print() << "HILBERT " << nside << "^" << AMREX_SPACEDIM << " boxes: "
+                   << (nbad == 0 ? "consecutive boxes share a face, passed\n"
+                                 : "consecutive boxes do not share a face, FAILED\n");
+    return nbad;
+}
+
+// Smallest heaviest chain over all cuts of w into nchains nonempty chains.
+Long best_bottleneck (std::vector<Long> const& w, int start, int nchains)
+{
+    const int n = static_cast<int>(w.size());
+    if (nchains == 1) {
+        Long s = 0;
+        for (int i = start; i < n; ++i) { s += w[i]; }
+        return s;
+    }
+    Long best = std::numeric_limits<Long>::max();
+    Long s = 0;
+    for (int end = start+1; end <= n-(nchains-1); ++end) {
+        s += w[end-1];
+        best = std::min(best, std::max(s, best_bottleneck(w, end, nchains-1)));
+    }
+    return best;
+}
+
+// The HILBERT chains are contiguous pieces of the curve, and their
+// heaviest is as light as the best of all the cuts.
+int hilbert_chains ()
+{
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> extent(1, 8);
+    const int ncells = AMREX_D_TERM(4,*4,*4);
+
+    int nbad = 0;
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        const int nboxes = std::uniform_int_distribution<int>(2, 10)(gen);
+        std::vector<int> cells(ncells);
+        std::iota(cells.begin(), cells.end(), 0);
+        std::shuffle(cells.begin(), cells.end(), gen);
+
+        BoxList bl;
+        for (int b = 0; b < nboxes; ++b) {
+            IntVect lo(AMREX_D_DECL(8*(cells[b]%4), 8*((cells[b]/4)%4), 8*(cells[b]/16)));
+            IntVect hi = lo;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                hi[idim] += extent(gen) - 1;
+            }
+            bl.push_back(Box(lo, hi));
+        }
+        const BoxArray ba(std::move(bl));
+
+        const std::vector<int> order = curve_order(ba);
+        std::vector<Long> w;
+        for (int i : order) { w.push_back(ba[i].numPts()); }
+
+        const int nchains = std::uniform_int_distribution<int>(1, std::min(4, nboxes))(gen);
+        const auto chains = DistributionMapping::makeSFC(ba, true, nchains);
+
+        std::vector<int> joined;
+        Long bottleneck = 0;
+        bool empty = false;
+        for (auto const& chain : chains) {
+            Long s = 0;
+            for (int i : chain) { s += ba[i].numPts(); }
+            bottleneck = std::max(bottleneck, s);
+            empty = empty || chain.empty();
+            joined.insert(joined.end(), chain.begin(), chain.end());
+        }
+
+        const Long best = best_bottleneck(w, 0, nchains);
+        if (joined != order || empty || bottleneck != best) {
+            amrex::Print() << "HILBERT chains of " << nboxes << " boxes on " << nchains
+                           << " ranks: heaviest " << bottleneck << ", best " << best
+                           << (joined != order ? ", not contiguous" : "")
+                           << (empty ? ", empty chain" : "") << ", FAILED\n";
+            ++nbad;
+        }
+    }
+    if (nbad == 0) {
+        amrex::Print() << "HILBERT chains: contiguous and as light as the best cut, passed\n";
+    }
+    return nbad;
+}
+
+int hilbert_tests ()
+{
+    const auto strategy = DistributionMapping::strategy();
+    DistributionMapping::strategy(DistributionMapping::HILBERT);
+
+    int nbad = 0;
+    for (int nside : {2, 4, 8}) {
+        nbad += hilbert_adjacency(nside);
+    }
+    nbad += hilbert_chains();
+
+    DistributionMapping::strategy(strategy);
+    return nbad;
+}
+
+// Rebalance a mapping of a uniform grid for weights four times heavier in
+// one corner.  The efficiency must reach the target, the moved bytes must
+// be those of the boxes that changed rank and fewer than a full remap
+// moves, and a mapping that already meets the target must not change.
+// The ranks are those of the current communicator.
+int incremental (Real target)
+{
+    const int nprocs = ParallelContext::NProcsSub();
+    const Box domain(IntVect(0), IntVect(63));
+    BoxArray ba(domain);
+    ba.maxSize(8);
+    const int N = static_cast<int>(ba.size());
+
+    std::vector<Long> wgts(N), bytes(N);
+    Vector<Real> cost(N);
+    for (int i = 0; i < N; ++i) {
+        wgts[i] = ba[i].numPts();
+        bytes[i] = ba[i].numPts()*Long(sizeof(Real));
+        const Box b = ba[i];
+        cost[i] = b.smallEnd() < IntVect(32) ? Real(4) : Real(1);
+    }
+    DistributionMapping olddm;
+    olddm.SFCProcessorMap(ba, wgts, nprocs);
+
+    Real old_eff = 0, new_eff = 0;
+    Long moved_bytes = 0;
+    const Vector<Long> vbytes(bytes.begin(), bytes.end());
+    const DistributionMapping dm = DistributionMapping::makeIncremental(olddm, cost, vbytes, target,
+                                                                        old_eff, new_eff, moved_bytes);
+
+    std::vector<Long> new_wgts(N);
+    for (int i = 0; i < N; ++i) {
+        new_wgts[i] = Long(cost[i]);
+    }
+    DistributionMapping full;
+    full.SFCProcessorMap(ba, new_wgts, nprocs);
+
+    Vector<int> lrank(N);
+    ParallelContext::global_to_local_rank(lrank.data(), dm.ProcessorMap().data(), N);
+    Long sum_moved = 0, full_moved = 0;
+    int nmoved = 0, nbad = 0;
+    for (int i = 0; i < N; ++i) {
+        if (lrank[i] < 0 || lrank[i] >= nprocs) { ++nbad; }
+        if (dm[i] != olddm[i]) {
+            sum_moved += bytes[i];
+            ++nmoved;
+        }
+        if (full[i] != olddm[i]) { full_moved += bytes[i]; }
+    }
+    Vector<Long> load(nprocs, 0);
+    Long sum_wgt = 0;
+    for (int i = 0; i < N; ++i) {
+        if (lrank[i] >= 0 && lrank[i] < nprocs) { load[lrank[i]] += new_wgts[i]; }
+        sum_wgt += new_wgts[i];
+    }
+    const Real eff = static_cast<Real>(sum_wgt) /
+        (static_cast<Real>(nprocs) * static_cast<Real>(*std::max_element(load.begin(), load.end())));
+
+    if (nbad > 0 || new_eff < old_eff || new_eff < target || std::abs(eff - new_eff) > Real(1.e-6)
+        || sum_moved != moved_bytes || (full_moved > 0 && moved_bytes >= full_moved))
+    {
+        ++nbad;
+    }
+
+    // Rebalancing the result for the same target moves nothing.
+    Real eff2 = 0, new_eff2 = 0;
+    Long moved_bytes2 = 0;
+    const DistributionMapping dm2 = DistributionMapping::makeIncremental(dm, cost, vbytes, target,
+                                                                         eff2, new_eff2, moved_bytes2);
+    if (moved_bytes2 != 0 || dm2 != dm) { ++nbad; }
+
+    amrex::Print() << "Incremental to " << target << " on " << nprocs << " ranks: efficiency "
+                   << old_eff << " -> " << new_eff << ", " << nmoved << " boxes, "
+                   << moved_bytes << " bytes moved, full remap " << full_moved << " bytes"
+                   << (nbad == 0 ? ", passed\n" : ", FAILED\n");
+    return nbad;
+}
+
+// The incremental rebalance in the whole communicator, and in one without
+// the first rank whose ranks are in reverse order.
+int incremental_tests ()
+{
+    int nbad = 0;
+    for (Real target : {Real(0.9), Real(0.97)}) {
+        nbad += incremental(target);
+    }
+
+#ifdef BL_USE_MPI
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int rank = ParallelDescriptor::MyProc();
+    const int color = (nprocs > 2 && rank == 0) ? 1 : 0;
+    MPI_Comm comm;
+    MPI_Comm_split(ParallelDescriptor::Communicator(), color, nprocs-1-rank, &comm);
+    ParallelContext::push(comm);
+    nbad += incremental(Real(0.9));
+    ParallelContext::pop();
+    MPI_Comm_free(&comm);
+#endif
+
+    return nbad;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nbad = graph_tests();
+        nbad += hilbert_tests();
+        nbad += incremental_tests();
+
+        if (nbad != 0) {
+            amrex::Abort("DistributionMapping test failed");
+        }
+    }
+    amrex::Finalize();
+}
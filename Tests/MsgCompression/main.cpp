@@ -0,0 +1,146 @@
+#include <AMReX.H>
+#include <AMReX_MsgCompression.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace amrex;
+
+// Round trips of each codec for float and double messages, and a
+// FillBoundary with quantized messages.
+
+namespace {
+
+// Smooth data with noise, an outlier, and values far from zero, so that
+// the quantizer sees both narrow chunks and chunks it has to store raw.
+template <typename T>
+Vector<T> make_data (std::size_t n, double offset)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> noise(-1.e-3, 1.e-3);
+    Vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<T>(offset + std::sin(0.01*double(i)) + noise(gen));
+    }
+    v[n/3] = static_cast<T>(offset + 1.e5);
+    return v;
+}
+
+// A message that cannot be made shorter is sent as it is, which is only a
+// failure if the codec should have compressed it.
+template <typename T>
+int round_trip (MsgCompression::Codec codec, char const* codec_name, Real tol, double offset,
+                bool must_compress)
+{
+    const std::size_t n = 5000;
+    Vector<T> in = make_data<T>(n, offset);
+    const std::size_t nbytes = n*sizeof(T);
+
+    // Messages in a receive buffer are not necessarily aligned.
+    Vector<char> src(nbytes+1), dst(nbytes), out(nbytes+1);
+    std::memcpy(src.data()+1, in.data(), nbytes);
+
+    const std::size_t r = MsgCompression::compress(codec, tol, sizeof(T), src.data()+1, nbytes,
+                                                   dst.data(), dst.size());
+    if (r == 0) {
+        amrex::Print() << codec_name << " " << sizeof(T) << " bytes, offset " << offset
+                       << ": not compressed" << (must_compress ? ", FAILED\n" : "\n");
+        return must_compress ? 1 : 0;
+    }
+    MsgCompression::decompress(sizeof(T), dst.data(), r, out.data()+1, nbytes);
+
+    int nbad = 0;
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        T x;
+        std::memcpy(&x, out.data()+1+i*sizeof(T), sizeof(T));
+        const double err = std::abs(double(x) - double(in[i]));
+        max_err = std::max(max_err, err);
+        if (codec == MsgCompression::Codec::quantize) {
+            if (!(err <= double(tol))) { ++nbad; }
+        } else if (codec == MsgCompression::Codec::float32) {
+            if (x != static_cast<T>(static_cast<float>(in[i]))) { ++nbad; }
+        } else if (x != in[i]) {
+            ++nbad;
+        }
+    }
+
+    amrex::Print() << codec_name << " " << sizeof(T) << " bytes, offset " << offset
+                   << ": ratio " << double(nbytes)/double(r) << ", max error " << max_err
+                   << (nbad == 0 ? ", passed\n" : ", FAILED\n");
+    return nbad;
+}
+
+template <typename T>
+int round_trips ()
+{
+    int nbad = 0;
+    for (double offset : {0.0, 1.e4}) {
+        nbad += round_trip<T>(MsgCompression::Codec::float32, "float32", 0, offset,
+                              sizeof(T) > sizeof(float));
+        nbad += round_trip<T>(MsgCompression::Codec::lossless, "lossless", 0, offset, true);
+        for (Real tol : {Real(1.e-2), Real(1.e-4), Real(1.e-7)}) {
+            nbad += round_trip<T>(MsgCompression::Codec::quantize, "quantize", tol, offset,
+                                  tol > Real(1.e-6));
+        }
+    }
+    return nbad;
+}
+
+int fill_boundary (Real tol)
+{
+    const Box domain(IntVect(0), IntVect(31));
+    BoxArray ba(domain);
+    ba.maxSize(8);
+    const DistributionMapping dm(ba);
+    const Periodicity period(domain.length());
+
+    MultiFab ref(ba, dm, 2, 2), mf(ba, dm, 2, 2);
+    for (MFIter mfi(ref); mfi.isValid(); ++mfi) {
+        auto const& a = ref.array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), 2, [&] (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = 1.e3 + std::sin(0.1*i) * std::cos(0.2*j) + 0.01*k + n;
+        });
+    }
+    MultiFab::Copy(mf, ref, 0, 0, 2, 0);
+    ref.FillBoundary(period);
+
+    FabArrayBase::comm_compression = MsgCompression::Codec::quantize;
+    FabArrayBase::comm_compression_tol = tol;
+    FabArrayBase::comm_compression_min_bytes = 0;
+    FabArrayBase::comm_compression_intranode = true;
+    {
+        MultiFab tmp(ba, dm, 2, 2);
+        MultiFab::Copy(tmp, mf, 0, 0, 2, 0);
+        tmp.FillBoundary(period);
+        MultiFab::Copy(mf, tmp, 0, 0, 2, 2);
+    }
+    FabArrayBase::comm_compression = MsgCompression::Codec::none;
+
+    MultiFab::Subtract(mf, ref, 0, 0, 2, 2);
+    const Real err = mf.norminf(0, 2, IntVect(2));
+    amrex::Print() << "FillBoundary with quantize tol " << tol << ": max error " << err
+                   << (err <= tol ? ", passed\n" : ", FAILED\n");
+    return (err <= tol) ? 0 : 1;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int nbad = round_trips<double>() + round_trips<float>();
+        nbad += fill_boundary(Real(1.e-6));
+
+        if (nbad != 0) {
+            amrex::Abort("MsgCompression test failed");
+        }
+    }
+    amrex::Finalize();
+}
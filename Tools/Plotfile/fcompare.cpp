@@ -15,6 +15,17 @@ struct ErrZone {
     IntVect cell;
 };
 
+// Whether two BoxArrays hold the same boxes, possibly in a different order.
+bool SameBoxes (BoxArray const& ba_a, BoxArray const& ba_b)
+{
+    if (ba_a.size() != ba_b.size()) { return false; }
+    Vector<Box> boxes_a = ba_a.boxList().data();
+    Vector<Box> boxes_b = ba_b.boxList().data();
+    std::sort(boxes_a.begin(), boxes_a.end());
+    std::sort(boxes_b.begin(), boxes_b.end());
+    return boxes_a == boxes_b;
+}
+
 void PrintUsage()
 {
     amrex::Print()
@@ -24,7 +35,7 @@ void PrintUsage()
         << " variable.\n"
         << "\n"
         << " usage:\n"
-        << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] file1 file2\n"
+        << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] [-e|--error_bound eb] file1 file2\n"
         << "\n"
         << " optional arguments:\n"
         << "    -n|--norm num         : what norm to use (default is 0 for inf norm)\n"
@@ -35,6 +46,11 @@ void PrintUsage()
         << "    -a|--allow_diff_grids : allow different BoxArrays covering the same domain\n"
         << "    -r|--rel_tol rtol     : relative tolerance (default is 0)\n"
         << "    --abs_tol atol        : absolute tolerance (default is 0)\n"
+        << "    -e|--error_bound eb   : absolute error bound of a lossy compressor;\n"
+        << "                            report max error / eb and PSNR per level\n"
+        << "\n"
+        << " Either file may be an HDF5 plotfile (e.g., plt00010.h5).  The\n"
+        << " compression metrics are always reported when one of them is.\n"
         << std::endl;
 }
 
@@ -57,6 +73,7 @@ int main_main()
     int allow_diff_grids = false;
     Real rtol = 0.0;
     Real atol = 0.0;
+    Real error_bound = 0.0;
     std::string zone_info_var_name;
     Vector<std::string> plot_names(1);
     bool abort_if_not_all_found = false;
@@ -85,6 +102,8 @@ int main_main()
             rtol = Real(std::stod(amrex::get_command_argument(++farg)));
         } else if (fname == "--abs_tol") {
             atol = Real(std::stod(amrex::get_command_argument(++farg)));
+        } else if (fname == "-e" || fname == "--error_bound") {
+            error_bound = Real(std::stod(amrex::get_command_argument(++farg)));
         } else if (fname == "--abort_if_not_all_found") {
             abort_if_not_all_found = true;
         } else {
@@ -109,6 +128,11 @@ int main_main()
     PlotFileData pf_b(plotfile_b);
     pf_b.syncDistributionMap(pf_a);
 
+    // The HDF5 writer stores the boxes sorted by rank, so the BoxArrays of an
+    // HDF5 plotfile and of the native plotfile it came from only differ in order.
+    const bool compressed = pf_a.isHDF5() || pf_b.isHDF5();
+    const bool report_compression = compressed || error_bound > 0.;
+
     const int dm = pf_a.spaceDim();
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(pf_a.spaceDim() == pf_b.spaceDim(),
                                      "ERROR: plotfiles have different numbers of spatial dimensions");
@@ -196,7 +220,9 @@ int main_main()
             continue;
         }
         bool grids_match = pf_a.boxArray(ilev) == pf_b.boxArray(ilev);
-        if (!grids_match && !allow_diff_grids) {
+        const bool reordered = !grids_match && compressed &&
+            SameBoxes(pf_a.boxArray(ilev), pf_b.boxArray(ilev));
+        if (!grids_match && !allow_diff_grids && !reordered) {
             amrex::Abort("ERROR: grids do not match");
         } else if (!grids_match) {
             // do they cover the same domain?
@@ -211,6 +237,9 @@ int main_main()
         Vector<Real> rerror_denom(ncomp_a, 0.0);
         Vector<int> has_nan_a(ncomp_a, false);
         Vector<int> has_nan_b(ncomp_a, false);
+        Vector<Real> max_abs_err(ncomp_a, 0.0);
+        Vector<Real> psnr(ncomp_a, std::numeric_limits<Real>::infinity());
+        const auto npts = static_cast<Real>(pf_a.boxArray(ilev).numPts());
         for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
             if (ivar_b[icomp_a] >= 0) {
                 const MultiFab& mf_a = pf_a.get(ilev, names_a[icomp_a]);
@@ -224,8 +253,19 @@ int main_main()
                 }
                 has_nan_a[icomp_a] = mf_a.contains_nan();
                 has_nan_b[icomp_a] = mf_b.contains_nan();
+                Real value_range = 0.;
+                if (report_compression) {
+                    value_range = mf_a.max(0) - mf_a.min(0);
+                }
                 MultiFab::Subtract(mf_b,mf_a,0,0,1,0); // b = b - a
                 Real max_err = mf_b.norm0();
+                if (report_compression) {
+                    max_abs_err[icomp_a] = max_err;
+                    Real rmse = mf_b.norm2() / std::sqrt(npts);
+                    if (rmse > 0.) {
+                        psnr[icomp_a] = Real(20.) * std::log10(value_range / rmse);
+                    }
+                }
                 if (norm == 1) {
                     aerror[icomp_a] = mf_b.norm1();
                     rerror[icomp_a] = aerror[icomp_a];
@@ -311,6 +351,31 @@ int main_main()
             }
         }
 
+        if (report_compression) {
+            amrex::Print() << " " << std::setw(24) << std::right << "compression"
+                           << "  " << std::setw(24) << "max error / bound"
+                           << "  " << std::setw(24) << "PSNR (dB)" << "\n";
+            for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+                if (ivar_b[icomp_a] < 0 || has_nan_a[icomp_a] || has_nan_b[icomp_a]) {
+                    continue;
+                }
+                if (error_bound > 0.) {
+                    amrex::Print() << " " << std::setw(24) << std::left << names_a[icomp_a]
+                                   << std::right
+                                   << "  " << std::setw(24) << std::setprecision(10)
+                                   << max_abs_err[icomp_a] / error_bound
+                                   << "  " << std::setw(24) << std::setprecision(10)
+                                   << psnr[icomp_a] << "\n";
+                } else {
+                    amrex::Print() << " " << std::setw(24) << std::left << names_a[icomp_a]
+                                   << std::right
+                                   << "  " << std::setw(24) << "-"
+                                   << "  " << std::setw(24) << std::setprecision(10)
+                                   << psnr[icomp_a] << "\n";
+                }
+            }
+        }
+
         global_error = std::max(global_error,
                                 *(std::max_element(aerror.begin(),
                                                    aerror.end())));
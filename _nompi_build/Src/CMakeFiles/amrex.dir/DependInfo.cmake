@@ -0,0 +1,128 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Src/Amr/AMReX_Amr.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Amr.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Amr.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_AmrLevel.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_AmrLevel.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_AmrLevel.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_AuxBoundaryData.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_AuxBoundaryData.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_AuxBoundaryData.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_Derive.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Derive.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Derive.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_Extrapolater.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Extrapolater.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_Extrapolater.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_StateData.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_StateData.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_StateData.cpp.o.d"
+  "/root/repo/Src/Amr/AMReX_StateDescriptor.cpp" "Src/CMakeFiles/amrex.dir/Amr/AMReX_StateDescriptor.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Amr/AMReX_StateDescriptor.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_AmrCore.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_AmrCore.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_AmrCore.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_AmrMesh.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_AmrMesh.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_AmrMesh.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_Cluster.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_Cluster.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_Cluster.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_ErrorList.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_ErrorList.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_ErrorList.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_FillPatchUtil.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_FillPatchUtil.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_FillPatchUtil.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_FluxRegister.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_FluxRegister.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_FluxRegister.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_InterpBase.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_InterpBase.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_InterpBase.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_InterpFaceRegister.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_InterpFaceRegister.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_InterpFaceRegister.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_Interpolater.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_Interpolater.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_Interpolater.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_MFInterpolater.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_MFInterpolater.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_MFInterpolater.cpp.o.d"
+  "/root/repo/Src/AmrCore/AMReX_TagBox.cpp" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_TagBox.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/AmrCore/AMReX_TagBox.cpp.o.d"
+  "/root/repo/Src/Base/AMReX.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Arena.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Arena.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Arena.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_AsyncOut.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_AsyncOut.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_AsyncOut.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BArena.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BArena.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BArena.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BCRec.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BCRec.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BCRec.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BCUtil.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BCUtil.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BCUtil.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BLBackTrace.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BLBackTrace.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BLBackTrace.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BackgroundThread.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BackgroundThread.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BackgroundThread.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BaseFab.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BaseFab.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BaseFab.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BlockMutex.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BlockMutex.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BlockMutex.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Box.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Box.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Box.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BoxArray.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxArray.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxArray.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BoxDomain.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxDomain.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxDomain.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BoxIterator.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxIterator.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxIterator.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_BoxList.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxList.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_BoxList.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_CArena.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_CArena.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_CArena.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_CommProgress.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_CommProgress.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_CommProgress.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_CoordSys.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_CoordSys.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_CoordSys.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_DistributionMapping.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_DistributionMapping.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_DistributionMapping.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FArrayBox.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FArrayBox.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FArrayBox.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FPC.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FPC.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FPC.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FabArrayBase.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FabArrayBase.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FabArrayBase.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FabConv.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FabConv.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FabConv.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FilCC_C.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilCC_C.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilCC_C.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FilFC_C.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilFC_C.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilFC_C.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FilND_C.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilND_C.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FilND_C.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_FileSystem.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_FileSystem.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_FileSystem.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_ForkJoin.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_ForkJoin.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_ForkJoin.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Geometry.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Geometry.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Geometry.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_GpuAsyncArray.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuAsyncArray.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuAsyncArray.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_GpuControl.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuControl.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuControl.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_GpuDevice.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuDevice.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuDevice.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_GpuElixir.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuElixir.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuElixir.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_GpuUtility.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuUtility.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_GpuUtility.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_IArrayBox.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_IArrayBox.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_IArrayBox.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_IndexType.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_IndexType.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_IndexType.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_IntConv.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_IntConv.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_IntConv.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_IntVect.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_IntVect.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_IntVect.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MFCopyDescriptor.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MFCopyDescriptor.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MFCopyDescriptor.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MFIter.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MFIter.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MFIter.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Machine.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Machine.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Machine.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MemPool.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MemPool.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MemPool.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MsgCompression.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MsgCompression.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MsgCompression.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MultiFab.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MultiFab.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MultiFab.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_MultiFabUtil.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_MultiFabUtil.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_MultiFabUtil.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_NFiles.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_NFiles.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_NFiles.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_NonLocalBC.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_NonLocalBC.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_NonLocalBC.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Orientation.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Orientation.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Orientation.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_PArena.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_PArena.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_PArena.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_ParallelContext.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParallelContext.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParallelContext.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_ParallelDescriptor.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParallelDescriptor.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParallelDescriptor.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_ParmParse.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParmParse.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_ParmParse.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Periodicity.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Periodicity.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Periodicity.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_PhaseArena.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_PhaseArena.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_PhaseArena.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_PhysBCFunct.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_PhysBCFunct.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_PhysBCFunct.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_PlotFileDataImpl.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_PlotFileDataImpl.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_PlotFileDataImpl.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_PlotFileUtil.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_PlotFileUtil.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_PlotFileUtil.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Random.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Random.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Random.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_RealBox.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_RealBox.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_RealBox.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_RealVect.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_RealVect.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_RealVect.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Utility.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Utility.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Utility.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_VectorIO.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_VectorIO.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_VectorIO.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_Version.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_Version.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_Version.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_VisMF.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_VisMF.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_VisMF.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_error_fi.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_error_fi.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_error_fi.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_iMultiFab.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_iMultiFab.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_iMultiFab.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_parmparse_fi.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_parmparse_fi.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_parmparse_fi.cpp.o.d"
+  "/root/repo/Src/Base/AMReX_parstream.cpp" "Src/CMakeFiles/amrex.dir/Base/AMReX_parstream.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/AMReX_parstream.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_IParser.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_IParser_Exe.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Exe.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Exe.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_IParser_Y.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Y.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Y.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_Parser.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_Parser_Exe.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Exe.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Exe.cpp.o.d"
+  "/root/repo/Src/Base/Parser/AMReX_Parser_Y.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Y.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Y.cpp.o.d"
+  "/root/repo/Src/Base/Parser/amrex_iparser.lex.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.lex.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.lex.cpp.o.d"
+  "/root/repo/Src/Base/Parser/amrex_iparser.tab.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.tab.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.tab.cpp.o.d"
+  "/root/repo/Src/Base/Parser/amrex_parser.lex.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_parser.lex.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_parser.lex.cpp.o.d"
+  "/root/repo/Src/Base/Parser/amrex_parser.tab.cpp" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_parser.tab.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Base/Parser/amrex_parser.tab.cpp.o.d"
+  "/root/repo/Src/Boundary/AMReX_LO_BCTYPES.cpp" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_LO_BCTYPES.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_LO_BCTYPES.cpp.o.d"
+  "/root/repo/Src/Boundary/AMReX_Mask.cpp" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_Mask.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_Mask.cpp.o.d"
+  "/root/repo/Src/Boundary/AMReX_MultiMask.cpp" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_MultiMask.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/Boundary/AMReX_MultiMask.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLEBNodeFDLaplacian.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLEBNodeFDLaplacian.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLEBNodeFDLaplacian.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLMG.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLMG.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLMG.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeLaplacian.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_misc.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_misc.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_misc.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sten.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sten.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sten.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sync.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sync.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sync.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeLinOp.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLinOp.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLinOp.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLNodeTensorLaplacian.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeTensorLaplacian.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeTensorLaplacian.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLTensorOp.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/MLMG/AMReX_MLTensorOp_grad.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp_grad.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp_grad.cpp.o.d"
+  "/root/repo/Src/LinearSolvers/OpenBC/AMReX_OpenBC.cpp" "Src/CMakeFiles/amrex.dir/LinearSolvers/OpenBC/AMReX_OpenBC.cpp.o" "gcc" "Src/CMakeFiles/amrex.dir/LinearSolvers/OpenBC/AMReX_OpenBC.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,229 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/amrex.dir/Amr/AMReX_Amr.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_Amr.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_AmrLevel.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_AmrLevel.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_AuxBoundaryData.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_AuxBoundaryData.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_Derive.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_Derive.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_Extrapolater.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_Extrapolater.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_StateData.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_StateData.cpp.o.d"
+  "CMakeFiles/amrex.dir/Amr/AMReX_StateDescriptor.cpp.o"
+  "CMakeFiles/amrex.dir/Amr/AMReX_StateDescriptor.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_AmrCore.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_AmrCore.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_AmrMesh.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_AmrMesh.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_Cluster.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_Cluster.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_ErrorList.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_ErrorList.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_FillPatchUtil.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_FillPatchUtil.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_FluxRegister.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_FluxRegister.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_InterpBase.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_InterpBase.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_InterpFaceRegister.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_InterpFaceRegister.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_Interpolater.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_Interpolater.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_MFInterpolater.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_MFInterpolater.cpp.o.d"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_TagBox.cpp.o"
+  "CMakeFiles/amrex.dir/AmrCore/AMReX_TagBox.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Arena.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Arena.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_AsyncOut.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_AsyncOut.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BArena.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BArena.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BCRec.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BCRec.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BCUtil.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BCUtil.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BLBackTrace.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BLBackTrace.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BackgroundThread.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BackgroundThread.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BaseFab.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BaseFab.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BlockMutex.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BlockMutex.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Box.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Box.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxArray.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxArray.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxDomain.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxDomain.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxIterator.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxIterator.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxList.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_BoxList.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_CArena.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_CArena.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_CommProgress.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_CommProgress.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_CoordSys.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_CoordSys.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_DistributionMapping.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_DistributionMapping.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FArrayBox.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FArrayBox.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FPC.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FPC.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FabArrayBase.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FabArrayBase.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FabConv.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FabConv.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilCC_C.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilCC_C.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilFC_C.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilFC_C.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilND_C.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FilND_C.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_FileSystem.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_FileSystem.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_ForkJoin.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_ForkJoin.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Geometry.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Geometry.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuAsyncArray.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuAsyncArray.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuControl.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuControl.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuDevice.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuDevice.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuElixir.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuElixir.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuUtility.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_GpuUtility.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_IArrayBox.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_IArrayBox.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_IndexType.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_IndexType.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_IntConv.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_IntConv.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_IntVect.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_IntVect.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MFCopyDescriptor.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MFCopyDescriptor.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MFIter.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MFIter.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Machine.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Machine.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MemPool.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MemPool.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MsgCompression.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MsgCompression.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MultiFab.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MultiFab.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_MultiFabUtil.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_MultiFabUtil.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_NFiles.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_NFiles.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_NonLocalBC.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_NonLocalBC.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Orientation.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Orientation.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_PArena.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_PArena.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParallelContext.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParallelContext.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParallelDescriptor.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParallelDescriptor.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParmParse.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_ParmParse.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Periodicity.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Periodicity.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_PhaseArena.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_PhaseArena.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_PhysBCFunct.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_PhysBCFunct.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_PlotFileDataImpl.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_PlotFileDataImpl.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_PlotFileUtil.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_PlotFileUtil.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Random.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Random.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_RealBox.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_RealBox.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_RealVect.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_RealVect.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Utility.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Utility.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_VectorIO.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_VectorIO.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_Version.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_Version.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_VisMF.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_VisMF.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_error_fi.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_error_fi.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_iMultiFab.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_iMultiFab.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_parmparse_fi.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_parmparse_fi.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/AMReX_parstream.cpp.o"
+  "CMakeFiles/amrex.dir/Base/AMReX_parstream.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Exe.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Exe.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Y.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_IParser_Y.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Exe.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Exe.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Y.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/AMReX_Parser_Y.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.lex.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.lex.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.tab.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_iparser.tab.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_parser.lex.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_parser.lex.cpp.o.d"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_parser.tab.cpp.o"
+  "CMakeFiles/amrex.dir/Base/Parser/amrex_parser.tab.cpp.o.d"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_LO_BCTYPES.cpp.o"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_LO_BCTYPES.cpp.o.d"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_Mask.cpp.o"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_Mask.cpp.o.d"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_MultiMask.cpp.o"
+  "CMakeFiles/amrex.dir/Boundary/AMReX_MultiMask.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLEBNodeFDLaplacian.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLEBNodeFDLaplacian.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLMG.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLMG.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_misc.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_misc.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sten.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sten.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sync.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLaplacian_sync.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLinOp.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeLinOp.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeTensorLaplacian.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLNodeTensorLaplacian.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp_grad.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/MLMG/AMReX_MLTensorOp_grad.cpp.o.d"
+  "CMakeFiles/amrex.dir/LinearSolvers/OpenBC/AMReX_OpenBC.cpp.o"
+  "CMakeFiles/amrex.dir/LinearSolvers/OpenBC/AMReX_OpenBC.cpp.o.d"
+  "libamrex.a"
+  "libamrex.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/amrex.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()